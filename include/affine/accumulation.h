@@ -0,0 +1,25 @@
+#pragma once
+
+#include "affine/affine_fwd.h"
+
+namespace affine {
+
+// Scalar type used for dot products and norms in orthonormalization and
+// membership tests. Specialize to decouple storage from accumulation
+// precision, e.g. to keep bases in float while accumulating in double.
+template<class ScalarT>
+struct Accumulation
+{
+  using type = ScalarT;
+};
+
+template<>
+struct Accumulation<float>
+{
+  using type = double;
+};
+
+template<class ScalarT>
+using accumulation_t = typename Accumulation<ScalarT>::type;
+
+} // namespace affine
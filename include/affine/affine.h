@@ -1,5 +1,26 @@
 #pragma once
 
+// Core of the library. The features running their own threads or keeping
+// shared state are opt-in, so that including this header does not pull in
+// <thread>, <random> and the like:
+//   affine/arrangement.h - parallel hyperplane arrangement vertices
+//   affine/fitting.h     - Flat_fitter and parallel RANSAC
+//   affine/flat_cache.h  - sharded cache of canonical flats
+//   affine/pipeline.h    - streaming intersections over a thread pool
+
+#include "affine/affine_fwd.h"
+#include "affine/accumulation.h"
+#include "affine/affine_hull.h"
 #include "affine/affine_space.h"
+#include "affine/bounded_affine_space.h"
+#include "affine/canonical.h"
+#include "affine/compact_affine_space.h"
+#include "affine/coordinate_space.h"
+#include "affine/filtered.h"
+#include "affine/flat_collection.h"
 #include "affine/intersection.h"
-#include "affine/comparisons.h"
\ No newline at end of file
+#include "affine/plucker.h"
+#include "affine/prepared_affine_space.h"
+#include "affine/transform.h"
+#include "affine/comparisons.h"
+#include "affine/detail/explicit_instantiations.h"
\ No newline at end of file
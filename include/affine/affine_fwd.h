@@ -0,0 +1,99 @@
+#pragma once
+
+#include <concepts>
+#include <optional>
+
+// Forward declarations of the library types and of the intersection of
+// flats. Does not include capd, so it is cheap to include in headers that
+// only pass flats around by reference. A translation unit linking the affine
+// library may call the declared intersections for the explicitly
+// instantiated scalars and dimensions with only affine_space.h and this
+// header included; the kernels of intersection.h are compiled in the
+// library.
+//
+// Every header defining one of these types includes this one, so the
+// declarations cannot drift from the definitions.
+
+namespace affine {
+
+struct Orthonormal_tag;
+
+template<class ScalarT>
+struct Accumulation;
+
+template<class ScalarT, unsigned AmbientDim>
+class Affine_space;
+
+template<class ScalarT, unsigned AmbientDim>
+class Prepared_affine_space;
+
+template<class ScalarT, unsigned AmbientDim>
+class Bounded_affine_space;
+
+template<class ScalarT, unsigned AmbientDim>
+class Coordinate_space;
+
+template<class ScalarT, unsigned AmbientDim, class StorageT = ScalarT>
+  requires std::floating_point<ScalarT> && std::floating_point<StorageT>
+class Compact_affine_space;
+
+template<class ScalarT, unsigned AmbientDim>
+class Flat_collection;
+
+template<unsigned AmbientDim>
+class Filtered_affine_space;
+
+template<class ScalarT>
+class Plucker_line;
+
+template<class ScalarT>
+struct Plucker_lines;
+
+template<class ScalarT, unsigned AmbientDim, class F>
+class Flat_cache;
+
+template<class ScalarT, unsigned AmbientDim>
+  requires std::floating_point<ScalarT>
+class Flat_fitter;
+
+struct Ransac_parameters;
+
+template<class ScalarT, unsigned AmbientDim>
+struct Arrangement_vertex;
+
+struct Arrangement_parameters;
+
+struct Pipeline_parameters;
+
+template<class Input, class Output>
+class Pipeline;
+
+class Equal_to_precision;
+
+class IApprox_equal;
+
+template<class ScalarT, unsigned AmbientDim, class F>
+std::optional<Affine_space<ScalarT, AmbientDim>>
+intersection(const Affine_space<ScalarT, AmbientDim>& lhs,
+             const Affine_space<ScalarT, AmbientDim>& rhs,
+             F compare);
+
+template<class ScalarT, unsigned AmbientDim, class F>
+std::optional<Affine_space<ScalarT, AmbientDim>>
+intersection(Affine_space<ScalarT, AmbientDim>&& lhs,
+             const Affine_space<ScalarT, AmbientDim>& rhs,
+             F compare);
+
+template<class ScalarT, unsigned AmbientDim, class F>
+std::optional<Affine_space<ScalarT, AmbientDim>>
+intersection(const Affine_space<ScalarT, AmbientDim>& lhs,
+             Affine_space<ScalarT, AmbientDim>&& rhs,
+             F compare);
+
+template<class ScalarT, unsigned AmbientDim, class F>
+std::optional<Affine_space<ScalarT, AmbientDim>>
+intersection(Affine_space<ScalarT, AmbientDim>&& lhs,
+             Affine_space<ScalarT, AmbientDim>&& rhs,
+             F compare);
+
+} // namespace affine
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <ranges>
+#include <stdexcept>
+#include <vector>
+
+#include "affine/affine_space.h"
+#include "affine/detail/affine_detail.h"
+
+namespace affine {
+
+namespace detail {
+
+template<class T, class F>
+void
+extend_orthonormal_base(std::vector<T>& base,
+                        std::vector<T> candidates,
+                        F compare)
+{
+  const auto ambient_dim = static_cast<std::size_t>(T().dimension());
+  for (auto& c : candidates)
+    for (auto&& v : base)
+      c -= (v * c) * v;
+  const auto dim =
+    gram_schmidt_orthonormalization(candidates, std::move(compare));
+  candidates.resize(std::min(static_cast<std::size_t>(dim),
+                             ambient_dim - std::min(ambient_dim, base.size())));
+  base.insert(base.end(), candidates.begin(), candidates.end());
+}
+
+template<class ScalarT, unsigned AmbientDim, class F>
+void
+extend_hull(const Affine_space<ScalarT, AmbientDim>& seed,
+            std::vector<Point<ScalarT, AmbientDim>>& base,
+            const Affine_space<ScalarT, AmbientDim>& other,
+            F compare)
+{
+  auto candidates = other.base();
+  candidates.push_back(other.point() - seed.point());
+  extend_orthonormal_base(base, std::move(candidates), std::move(compare));
+}
+
+} // namespace detail
+
+// Smallest flat containing both arguments. The base of the higher
+// dimensional argument is kept and only the other base and the difference
+// of the particular points are orthogonalized against it.
+template<class ScalarT, unsigned AmbientDim, class F>
+Affine_space<ScalarT, AmbientDim>
+affine_hull(const Affine_space<ScalarT, AmbientDim>& lhs,
+            const Affine_space<ScalarT, AmbientDim>& rhs,
+            F compare)
+{
+  namespace rs = std::ranges;
+  using Aff_space = Affine_space<ScalarT, AmbientDim>;
+  const auto& [smaller, larger] =
+    rs::minmax(lhs, rhs, {}, std::mem_fn(&Aff_space::dimension));
+  auto base = larger.base();
+  detail::extend_hull(larger, base, smaller, std::move(compare));
+  return Aff_space(orthonormal, larger.point(), std::move(base));
+}
+
+template<std::ranges::forward_range R, class F>
+  requires detail::Is_affine_space<std::ranges::range_value_t<R>>::value
+std::ranges::range_value_t<R>
+affine_hull(R&& spaces, F compare)
+{
+  namespace rs = std::ranges;
+  using Aff_space = rs::range_value_t<R>;
+  if (rs::empty(spaces))
+    throw std::invalid_argument("'spaces' cannot be empty");
+  const auto seed =
+    rs::max_element(spaces, {}, std::mem_fn(&Aff_space::dimension));
+  auto base = seed->base();
+  for (auto iter = rs::begin(spaces); iter != rs::end(spaces); ++iter)
+    if (iter != seed)
+      detail::extend_hull(*seed, base, *iter, compare);
+  return Aff_space(orthonormal, seed->point(), std::move(base));
+}
+
+} // namespace affine
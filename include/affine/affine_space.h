@@ -5,38 +5,49 @@
 #include <ranges>
 #include <span>
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Woverloaded-virtual"
-#include <capd/capdlib.h>
-#pragma GCC diagnostic pop
-
+#include "affine/affine_fwd.h"
 #include "affine/detail/affine_detail.h"
+#include "affine/detail/capd.h"
 
 namespace affine {
 
+struct Orthonormal_tag
+{
+  explicit Orthonormal_tag() = default;
+};
+
+inline constexpr Orthonormal_tag orthonormal{};
+
+namespace detail {
+
+struct Transform_access;
+
+} // namespace detail
+
 template<class ScalarT, unsigned AmbientDim>
 class Affine_space
 {
 public:
   using Scalar = ScalarT;
   using Point = detail::Point<ScalarT, AmbientDim>;
+  using Matrix = detail::Matrix<ScalarT, AmbientDim, AmbientDim>;
 
   Affine_space() = default;
 
-  Affine_space(const Point& particular_point)
-    : particular_point_{ particular_point }
+  Affine_space(Point particular_point)
+    : particular_point_{ std::move(particular_point) }
   {
   }
 
   template<std::ranges::input_range R, class F>
     requires std::convertible_to<std::ranges::range_value_t<R>, Point> &&
              std::ranges::sized_range<R>
-  explicit Affine_space(const Point& particular_point,
-                        R&& generators,
-                        F compare)
-    : particular_point_(particular_point)
+  explicit Affine_space(Point particular_point, R&& generators, F compare)
+    : particular_point_(std::move(particular_point))
   {
     namespace rs = std::ranges;
     base_.resize(rs::size(generators));
@@ -47,23 +58,37 @@ public:
   }
 
   template<class F>
-  explicit Affine_space(const Point& particular_point,
+  explicit Affine_space(Point particular_point,
                         std::vector<Point> generators,
                         F compare)
-    : particular_point_(particular_point)
+    : particular_point_(std::move(particular_point))
     , base_(std::move(generators))
   {
     const auto dim = detail::gram_schmidt_orthonormalization(base_, std::move(compare));
     base_.resize(dim);
   }
 
+  // 'base' must already be orthonormal, it is stored as is.
+  explicit Affine_space(Orthonormal_tag,
+                        Point particular_point,
+                        std::vector<Point> base)
+    : particular_point_(std::move(particular_point))
+    , base_(std::move(base))
+  {
+  }
+
   constexpr std::size_t ambient_dimension() const { return AmbientDim; }
 
   std::size_t dimension() const { return base_.size(); }
 
-  const Point& point() const { return particular_point_; }
+  const Point& point() const& { return particular_point_; }
+
+  Point point() && { return std::move(particular_point_); }
+
+  const std::vector<Point>& base() const& { return base_; }
 
-  const std::vector<Point>& base() const { return base_; }
+  // Takes the base out of an expiring space, leaving it zero dimensional.
+  std::vector<Point> base() && { return std::move(base_); }
 
   const Point& base(std::size_t i) const { return base_.at(i); }
 
@@ -74,6 +99,16 @@ public:
       particular_point_ - point, base_, std::move(compare));
   }
 
+  // Replaces the space with its image under x -> map * x + translation. If
+  // 'map' is conformal (an orthogonal map up to scale) the mapped base stays
+  // orthogonal and only needs rescaling; otherwise it is orthonormalized
+  // again from scratch.
+  template<class F>
+  void transform(const Matrix& map, const Point& translation, F compare)
+  {
+    transform_impl(map, translation, detail::conformal(map, compare), compare);
+  }
+
   template<std::ranges::input_range R, class F>
     requires std::convertible_to<std::ranges::range_value_t<R>, Point> &&
              std::ranges::sized_range<R> &&
@@ -83,6 +118,23 @@ public:
     return spanning_space_impl(std::move(points), std::move(compare));
   }
 
+  // Orthonormalizes the storage of 'points' in place.
+  template<class F>
+  static Affine_space spanning_space(std::vector<Point>&& points, F compare)
+  {
+    if (points.empty())
+      throw std::invalid_argument("'points' cannot be empty");
+    // The order of the directions is irrelevant, so the slot of the head is
+    // refilled from the back instead of shifting every point.
+    auto head = std::move(points.front());
+    if (points.size() > 1)
+      points.front() = std::move(points.back());
+    points.pop_back();
+    for (auto& p : points)
+      p -= head;
+    return Affine_space(std::move(head), std::move(points), std::move(compare));
+  }
+
   template<class F>
   static Affine_space spanning_space(std::initializer_list<Point> il, F compare)
   {
@@ -90,6 +142,31 @@ public:
   }
 
 private:
+  friend struct detail::Transform_access;
+
+  // As transform, with 'conformal_map' being detail::conformal(map, compare)
+  // decided once for a whole batch of flats. Not public, since a wrong
+  // 'conformal_map' would leave a base that is not orthonormal.
+  template<class F>
+  void transform_impl(const Matrix& map,
+                      const Point& translation,
+                      bool conformal_map,
+                      F compare)
+  {
+    particular_point_ = map * particular_point_ + translation;
+    for (auto& v : base_)
+      v = map * v;
+    if (conformal_map) {
+      if (!base_.empty() && !compare(base_[0] * base_[0], 1))
+        for (auto& v : base_)
+          v.normalize();
+    } else {
+      const auto dim =
+        detail::gram_schmidt_orthonormalization(base_, std::move(compare));
+      base_.resize(dim);
+    }
+  }
+
   template<std::ranges::input_range R, class F>
     requires std::convertible_to<std::ranges::range_value_t<R>, Point> &&
              std::ranges::sized_range<R>
@@ -109,6 +186,21 @@ private:
   std::vector<Point> base_{};
 };
 
+namespace detail {
+
+template<class T>
+struct Is_affine_space : std::false_type
+{};
+
+template<class ScalarT, unsigned AmbientDim>
+struct Is_affine_space<Affine_space<ScalarT, AmbientDim>> : std::true_type
+{
+  using scalar = ScalarT;
+  static constexpr unsigned ambient_dim = AmbientDim;
+};
+
+} // namespace detail
+
 template<class ScalarT, unsigned AmbientDim>
 std::ostream&
 operator<<(std::ostream& out,
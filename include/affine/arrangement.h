@@ -0,0 +1,241 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <optional>
+#include <ranges>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "affine/affine_fwd.h"
+#include "affine/affine_space.h"
+#include "affine/canonical.h"
+#include "affine/detail/affine_detail.h"
+#include "affine/detail/capd.h"
+#include "affine/detail/intersection_detail.h"
+
+namespace affine {
+
+template<class ScalarT, unsigned AmbientDim>
+struct Arrangement_vertex
+{
+  using Point = detail::Point<ScalarT, AmbientDim>;
+
+  Point point;
+  // Indices of the hyperplanes passing through 'point', in increasing order.
+  std::vector<std::size_t> hyperplanes;
+};
+
+struct Arrangement_parameters
+{
+  // Grid cell size of the vertex deduplication hash; should not be smaller
+  // than the distance 'compare' accepts as zero.
+  double resolution = 1e-9;
+  unsigned threads = 0;
+};
+
+namespace detail {
+
+template<class ScalarT, unsigned AmbientDim>
+struct Hyperplane
+{
+  Point<ScalarT, AmbientDim> normal;
+  ScalarT offset;
+};
+
+// Index of the grid cell containing x. Indices are clamped to +-2^62, so
+// that the conversion is defined and neighbouring indices do not overflow;
+// far away points then share a cell and are told apart by 'compare'.
+inline long long
+grid_cell(double x, double resolution)
+{
+  constexpr double limit = 0x1p62;
+  const auto cell = std::floor(x / resolution);
+  if (!(std::abs(cell) < limit))
+    return cell < 0 ? -static_cast<long long>(limit)
+                    : static_cast<long long>(limit);
+  return static_cast<long long>(cell);
+}
+
+template<unsigned AmbientDim>
+struct Cell_hash
+{
+  std::size_t operator()(const std::array<long long, AmbientDim>& cell) const
+  {
+    std::size_t seed = 0;
+    for (auto c : cell)
+      hash_combine(seed, std::hash<long long>{}(c));
+    return seed;
+  }
+};
+
+template<class ScalarT, unsigned AmbientDim, class F>
+void
+enumerate_vertices(
+  const std::vector<Hyperplane<ScalarT, AmbientDim>>& hyperplanes,
+  const Affine_space<ScalarT, AmbientDim>& prefix,
+  std::vector<std::size_t>& indices,
+  std::vector<Arrangement_vertex<ScalarT, AmbientDim>>& result,
+  const F& compare)
+{
+  for (auto j = indices.back() + 1; j < hyperplanes.size(); ++j) {
+    const auto next = space_with_hyperplane_intersection(
+      prefix, hyperplanes[j].normal, hyperplanes[j].offset, compare);
+    if (!next || next->dimension() == prefix.dimension())
+      continue;
+    indices.push_back(j);
+    if (next->dimension() == 0)
+      result.push_back({ next->point(), indices });
+    else
+      enumerate_vertices(hyperplanes, *next, indices, result, compare);
+    indices.pop_back();
+  }
+}
+
+} // namespace detail
+
+// Vertices of the arrangement of codimension 1 flats. Index tuples are
+// enumerated in increasing order only, in parallel over their first index,
+// and the partial intersection of a tuple's prefix is shared by all tuples
+// extending it. Coincident vertices are merged through a grid hash and
+// their incidences joined. An exception thrown while enumerating is rethrown
+// on the calling thread.
+template<
+  std::ranges::forward_range R,
+  class F,
+  class Traits = detail::Is_affine_space<std::ranges::range_value_t<R>>>
+  requires Traits::value
+std::vector<Arrangement_vertex<typename Traits::scalar, Traits::ambient_dim>>
+arrangement_vertices(R&& spaces,
+                     F compare,
+                     Arrangement_parameters parameters = {})
+{
+  using Scalar = typename Traits::scalar;
+  constexpr auto AmbientDim = Traits::ambient_dim;
+  using Vertex = Arrangement_vertex<Scalar, AmbientDim>;
+  using Cell = std::array<long long, AmbientDim>;
+
+  std::vector<Affine_space<Scalar, AmbientDim>> flats;
+  std::vector<detail::Hyperplane<Scalar, AmbientDim>> hyperplanes;
+  for (auto&& space : spaces) {
+    if (space.dimension() + 1 != AmbientDim)
+      throw std::invalid_argument("'spaces' must be of codimension 1");
+    const auto complement =
+      detail::orthonormal_complement(space.base(), compare);
+    if (complement.empty())
+      throw std::invalid_argument(
+        "'spaces' must have a normal distinguishable by 'compare'");
+    const auto& normal = complement.front();
+    hyperplanes.push_back({ normal, normal * space.point() });
+    flats.push_back(space);
+  }
+  std::atomic<std::size_t> next_first = 0;
+  const auto threads = std::max<std::size_t>(
+    1,
+    std::min<std::size_t>(
+      parameters.threads != 0
+        ? parameters.threads
+        : std::max(1u, std::thread::hardware_concurrency()),
+      hyperplanes.size()));
+  std::vector<std::vector<Vertex>> candidates(threads);
+  std::mutex error_mutex;
+  std::exception_ptr error;
+  auto worker = [&](std::size_t thread) {
+    try {
+      std::vector<std::size_t> indices;
+      for (auto i = next_first++; i < hyperplanes.size(); i = next_first++) {
+        indices.assign(1, i);
+        if (flats[i].dimension() == 0)
+          candidates[thread].push_back({ flats[i].point(), indices });
+        else
+          detail::enumerate_vertices(
+            hyperplanes, flats[i], indices, candidates[thread], compare);
+      }
+    } catch (...) {
+      next_first = hyperplanes.size();
+      std::lock_guard lock(error_mutex);
+      if (!error)
+        error = std::current_exception();
+    }
+  };
+  {
+    std::vector<std::jthread> pool;
+    for (std::size_t t = 1; t < threads; ++t)
+      pool.emplace_back(worker, t);
+    worker(0);
+  }
+  if (error)
+    std::rethrow_exception(error);
+
+  std::vector<Vertex> all;
+  for (auto&& c : candidates)
+    all.insert(all.end(),
+               std::make_move_iterator(c.begin()),
+               std::make_move_iterator(c.end()));
+  std::ranges::sort(all, {}, &Vertex::hyperplanes);
+
+  auto cell_of = [&parameters](const typename Vertex::Point& point) {
+    Cell cell;
+    for (std::size_t i = 0; i < AmbientDim; ++i)
+      cell[i] = detail::grid_cell(detail::representative(point[i]),
+                                  parameters.resolution);
+    return cell;
+  };
+  std::vector<Vertex> result;
+  std::unordered_map<Cell,
+                     std::vector<std::size_t>,
+                     detail::Cell_hash<AmbientDim>>
+    grid;
+  for (auto&& candidate : all) {
+    const auto cell = cell_of(candidate.point);
+    std::optional<std::size_t> match;
+    Cell neighbour = cell;
+    auto visit = [&](auto&& self, std::size_t axis) -> void {
+      if (match)
+        return;
+      if (axis == AmbientDim) {
+        if (const auto iter = grid.find(neighbour); iter != grid.end())
+          for (auto v : iter->second)
+            if (compare(capd::vectalg::euclNorm(result[v].point -
+                                                candidate.point),
+                        0)) {
+              match = v;
+              return;
+            }
+        return;
+      }
+      for (long long offset = -1; offset <= 1; ++offset) {
+        neighbour[axis] = cell[axis] + offset;
+        self(self, axis + 1);
+      }
+      neighbour[axis] = cell[axis];
+    };
+    visit(visit, 0);
+    if (match) {
+      auto& hyperplanes_through = result[*match].hyperplanes;
+      hyperplanes_through.insert(hyperplanes_through.end(),
+                                 candidate.hyperplanes.begin(),
+                                 candidate.hyperplanes.end());
+    } else {
+      grid[cell].push_back(result.size());
+      result.push_back(std::move(candidate));
+    }
+  }
+  for (auto&& vertex : result) {
+    std::ranges::sort(vertex.hyperplanes);
+    const auto [first, last] = std::ranges::unique(vertex.hyperplanes);
+    vertex.hyperplanes.erase(first, last);
+  }
+  return result;
+}
+
+} // namespace affine
@@ -0,0 +1,434 @@
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <ranges>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "affine/affine_fwd.h"
+#include "affine/affine_space.h"
+#include "affine/detail/affine_detail.h"
+#include "affine/detail/capd.h"
+#include "affine/intersection.h"
+
+namespace affine {
+
+// Convex subset of an Affine_space cut out by half-spaces. Constraints are
+// expressed in the coordinates of the space's orthonormal base relative to
+// its particular point, so clipping works in the flat's own dimension.
+template<class ScalarT, unsigned AmbientDim>
+class Bounded_affine_space
+{
+public:
+  using Scalar = ScalarT;
+  using Point = detail::Point<ScalarT, AmbientDim>;
+  using Aff_space = Affine_space<ScalarT, AmbientDim>;
+  using Coordinates = std::vector<ScalarT>;
+
+  // { u : normal * u <= offset }
+  struct Half_space
+  {
+    Coordinates normal;
+    ScalarT offset;
+  };
+
+  Bounded_affine_space() = default;
+
+  explicit Bounded_affine_space(Aff_space affine_space)
+    : affine_space_(std::move(affine_space))
+  {
+  }
+
+  explicit Bounded_affine_space(Aff_space affine_space,
+                                std::vector<Half_space> constraints)
+    : affine_space_(std::move(affine_space))
+  {
+    for (auto&& constraint : constraints)
+      add_constraint(std::move(constraint.normal), constraint.offset);
+  }
+
+  template<class F>
+  static Bounded_affine_space segment(const Point& a, const Point& b, F compare)
+  {
+    Bounded_affine_space result(
+      Aff_space::spanning_space({ a, b }, std::move(compare)));
+    if (result.dimension() == 0)
+      return result;
+    const auto length = result.coordinates(b)[0];
+    const bool forward = length > 0;
+    result.add_constraint({ ScalarT(forward ? -1 : 1) }, ScalarT(0));
+    result.add_constraint({ ScalarT(forward ? 1 : -1) },
+                          forward ? length : -length);
+    return result;
+  }
+
+  // 'vertices' must be the consecutive vertices of a convex polygon.
+  template<std::ranges::forward_range R, class F>
+    requires std::convertible_to<std::ranges::range_value_t<R>, Point> &&
+             std::ranges::sized_range<R>
+  static Bounded_affine_space polygon(R&& vertices, F compare)
+  {
+    Bounded_affine_space result(
+      Aff_space::spanning_space(vertices, std::move(compare)));
+    if (result.dimension() != 2)
+      throw std::invalid_argument("'vertices' must span a plane");
+    std::vector<Coordinates> local;
+    Coordinates centroid{ ScalarT(0), ScalarT(0) };
+    for (auto&& v : vertices) {
+      local.push_back(result.coordinates(v));
+      centroid[0] += local.back()[0];
+      centroid[1] += local.back()[1];
+    }
+    centroid[0] /= ScalarT(local.size());
+    centroid[1] /= ScalarT(local.size());
+    // The centroid lies strictly inside, so unlike a neighbouring vertex it
+    // is never on the line of an edge and orients every half-space inwards.
+    for (std::size_t i = 0; i < local.size(); ++i) {
+      const auto& u = local[i];
+      const auto& w = local[(i + 1) % local.size()];
+      Coordinates normal{ w[1] - u[1], u[0] - w[0] };
+      auto offset = normal[0] * u[0] + normal[1] * u[1];
+      if (normal[0] * centroid[0] + normal[1] * centroid[1] > offset) {
+        normal = { -normal[0], -normal[1] };
+        offset = -offset;
+      }
+      result.add_constraint(std::move(normal), offset);
+    }
+    return result;
+  }
+
+  std::size_t dimension() const { return affine_space_.dimension(); }
+
+  const Aff_space& affine_space() const { return affine_space_; }
+
+  const std::vector<Half_space>& constraints() const { return constraints_; }
+
+  void add_constraint(Coordinates normal, ScalarT offset)
+  {
+    if (normal.size() != dimension())
+      throw std::invalid_argument(
+        "constraint normal must match the dimension of the space");
+    constraints_.push_back({ std::move(normal), offset });
+  }
+
+  Coordinates coordinates(const Point& point) const
+  {
+    const auto diff = point - affine_space_.point();
+    Coordinates result;
+    result.reserve(dimension());
+    for (auto&& v : affine_space_.base())
+      result.push_back(v * diff);
+    return result;
+  }
+
+  Point to_ambient(const Coordinates& coordinates) const
+  {
+    auto result = affine_space_.point();
+    for (std::size_t i = 0; i < dimension(); ++i)
+      result += coordinates.at(i) * affine_space_.base(i);
+    return result;
+  }
+
+  template<class F>
+  bool element(const Point& point, F compare) const
+  {
+    if (!affine_space_.element(point, compare))
+      return false;
+    const auto u = coordinates(point);
+    for (auto&& constraint : constraints_) {
+      const auto value = dot(constraint.normal, u);
+      if (!(value <= constraint.offset || compare(value, constraint.offset)))
+        return false;
+    }
+    return true;
+  }
+
+  // A chart of dimension 2 is decided by clipping a polygon, in O(m^2) for m
+  // constraints. Other charts use Fourier-Motzkin elimination of the local
+  // coordinates, which is cheap in dimensions 0 and 1; every further
+  // coordinate eliminated may square the number of constraints, so in 3 or
+  // more dimensions it suits only a few dozen of them.
+  template<class F>
+  bool empty(F compare) const
+  {
+    if (dimension() == 2)
+      return clip(std::move(compare)).empty();
+    return eliminate(std::move(compare));
+  }
+
+private:
+  // Sutherland-Hodgman clipping by every constraint of a square containing
+  // every vertex of the region and, for constraints that are parallel
+  // according to 'compare', the point of each boundary line nearest to the
+  // origin; so the clipped polygon is empty only if the region is.
+  template<class F>
+  std::vector<Coordinates> clip(F compare) const
+  {
+    auto radius = ScalarT(1);
+    const auto extend = [&radius](ScalarT x) {
+      if (capd::abs(x) > radius)
+        radius = capd::abs(x);
+    };
+    for (std::size_t i = 0; i < constraints_.size(); ++i) {
+      const auto& a = constraints_[i];
+      const auto norm2 = dot(a.normal, a.normal);
+      if (norm2 > 0)
+        extend(a.offset * (capd::abs(a.normal[0]) + capd::abs(a.normal[1])) /
+               norm2);
+      for (std::size_t j = 0; j < i; ++j) {
+        const auto& b = constraints_[j];
+        if (compare(a.normal[0] * b.normal[1], a.normal[1] * b.normal[0]))
+          continue;
+        const auto det = a.normal[0] * b.normal[1] - a.normal[1] * b.normal[0];
+        extend((a.offset * b.normal[1] - b.offset * a.normal[1]) / det);
+        extend((b.offset * a.normal[0] - a.offset * b.normal[0]) / det);
+      }
+    }
+    std::vector<Coordinates> polygon{ { -radius, -radius },
+                                      { radius, -radius },
+                                      { radius, radius },
+                                      { -radius, radius } };
+    for (auto&& constraint : constraints_) {
+      std::vector<Coordinates> clipped;
+      for (std::size_t i = 0; i < polygon.size(); ++i) {
+        const auto& u = polygon[i];
+        const auto& w = polygon[(i + 1) % polygon.size()];
+        const auto u_value = dot(constraint.normal, u);
+        const auto w_value = dot(constraint.normal, w);
+        const bool u_inside = u_value <= constraint.offset ||
+                              compare(u_value, constraint.offset);
+        const bool w_inside = w_value <= constraint.offset ||
+                              compare(w_value, constraint.offset);
+        if (u_inside)
+          clipped.push_back(u);
+        if (u_inside == w_inside)
+          continue;
+        // A vertex inside only up to 'compare' may put the crossing slightly
+        // outside of the edge.
+        auto t = (constraint.offset - u_value) / (w_value - u_value);
+        if (t < 0)
+          t = 0;
+        if (t > 1)
+          t = 1;
+        clipped.push_back({ u[0] + t * (w[0] - u[0]), u[1] + t * (w[1] - u[1]) });
+      }
+      polygon = std::move(clipped);
+      if (polygon.empty())
+        break;
+    }
+    return polygon;
+  }
+
+  template<class F>
+  bool eliminate(F compare) const
+  {
+    auto rows = constraints_;
+    for (auto var = dimension(); var-- > 0;) {
+      std::vector<Half_space> next;
+      std::vector<const Half_space*> positive;
+      std::vector<const Half_space*> negative;
+      for (auto&& row : rows) {
+        if (compare(row.normal[var], 0))
+          next.push_back(row);
+        else if (row.normal[var] > 0)
+          positive.push_back(&row);
+        else
+          negative.push_back(&row);
+      }
+      for (auto&& p : positive) {
+        for (auto&& n : negative) {
+          const auto p_coef = p->normal[var];
+          const auto n_coef = -n->normal[var];
+          Half_space combined{ Coordinates(dimension()),
+                               n_coef * p->offset + p_coef * n->offset };
+          for (std::size_t i = 0; i < var; ++i)
+            combined.normal[i] = n_coef * p->normal[i] + p_coef * n->normal[i];
+          next.push_back(std::move(combined));
+        }
+      }
+      for (auto&& row : next)
+        row.normal[var] = 0;
+      rows = std::move(next);
+    }
+    for (auto&& row : rows)
+      if (row.offset < 0 && !compare(row.offset, 0))
+        return true;
+    return false;
+  }
+
+  static ScalarT dot(const Coordinates& lhs, const Coordinates& rhs)
+  {
+    ScalarT result{ 0 };
+    for (std::size_t i = 0; i < lhs.size(); ++i)
+      result += lhs[i] * rhs[i];
+    return result;
+  }
+
+  Aff_space affine_space_{};
+  std::vector<Half_space> constraints_{};
+};
+
+namespace detail {
+
+template<class ScalarT, unsigned AmbientDim>
+void
+restrict_constraints(const Bounded_affine_space<ScalarT, AmbientDim>& from,
+                     Bounded_affine_space<ScalarT, AmbientDim>& to)
+{
+  const auto& source = from.affine_space();
+  const auto& target = to.affine_space();
+  const auto shift = target.point() - source.point();
+  for (auto&& constraint : from.constraints()) {
+    Point<ScalarT, AmbientDim> direction{};
+    for (std::size_t i = 0; i < source.dimension(); ++i)
+      direction += constraint.normal[i] * source.base(i);
+    typename Bounded_affine_space<ScalarT, AmbientDim>::Coordinates normal;
+    normal.reserve(target.dimension());
+    for (auto&& v : target.base())
+      normal.push_back(direction * v);
+    to.add_constraint(std::move(normal), constraint.offset - direction * shift);
+  }
+}
+
+template<class ScalarT>
+struct Linear_solution
+{
+  std::vector<ScalarT> point;
+  std::vector<std::vector<ScalarT>> directions;
+};
+
+// Solutions point + span(directions) of the linear equations 'rows', each
+// given by its 'unknowns' coefficients followed by its right hand side;
+// std::nullopt if they are inconsistent.
+template<class ScalarT, class F>
+std::optional<Linear_solution<ScalarT>>
+solve_linear(std::vector<std::vector<ScalarT>> rows,
+             std::size_t unknowns,
+             F compare)
+{
+  std::vector<std::size_t> pivots;
+  for (std::size_t col = 0; col < unknowns && pivots.size() < rows.size();
+       ++col) {
+    const auto rank = pivots.size();
+    auto pivot = rank;
+    for (auto r = rank + 1; r < rows.size(); ++r)
+      if (capd::abs(rows[r][col]) > capd::abs(rows[pivot][col]))
+        pivot = r;
+    if (compare(rows[pivot][col], 0))
+      continue;
+    std::swap(rows[rank], rows[pivot]);
+    const auto pivot_value = rows[rank][col];
+    for (auto& x : rows[rank])
+      x /= pivot_value;
+    for (std::size_t r = 0; r < rows.size(); ++r) {
+      if (r == rank)
+        continue;
+      const auto factor = rows[r][col];
+      for (std::size_t k = col; k <= unknowns; ++k)
+        rows[r][k] -= factor * rows[rank][k];
+    }
+    pivots.push_back(col);
+  }
+  for (auto r = pivots.size(); r < rows.size(); ++r)
+    if (!compare(rows[r][unknowns], 0))
+      return std::nullopt;
+
+  Linear_solution<ScalarT> result{ std::vector<ScalarT>(unknowns), {} };
+  for (std::size_t i = 0; i < pivots.size(); ++i)
+    result.point[pivots[i]] = rows[i][unknowns];
+  for (std::size_t col = 0, i = 0; col < unknowns; ++col) {
+    if (i < pivots.size() && pivots[i] == col) {
+      ++i;
+      continue;
+    }
+    auto& direction = result.directions.emplace_back(unknowns);
+    direction[col] = 1;
+    for (std::size_t j = 0; j < pivots.size(); ++j)
+      direction[pivots[j]] = -rows[j][col];
+  }
+  return result;
+}
+
+// The part of 'chart' lying in 'flat', found by solving the equations of
+// 'flat' in the local coordinates of 'chart'. When all of 'chart' lies in
+// 'flat' it is returned as is, constraints included.
+template<class ScalarT, unsigned AmbientDim, class F>
+std::optional<Bounded_affine_space<ScalarT, AmbientDim>>
+restrict_chart(const Bounded_affine_space<ScalarT, AmbientDim>& chart,
+               const Affine_space<ScalarT, AmbientDim>& flat,
+               F compare)
+{
+  const auto& space = chart.affine_space();
+  const auto shift = flat.point() - space.point();
+  std::vector<std::vector<ScalarT>> rows;
+  for (auto&& normal : orthonormal_complement(flat.base(), compare)) {
+    auto& row = rows.emplace_back();
+    for (auto&& v : space.base())
+      row.push_back(normal * v);
+    row.push_back(normal * shift);
+  }
+  auto solution = solve_linear(std::move(rows), chart.dimension(), compare);
+  if (!solution)
+    return std::nullopt;
+  if (solution->directions.size() == chart.dimension())
+    return chart;
+  std::vector<Point<ScalarT, AmbientDim>> generators;
+  for (auto&& direction : solution->directions) {
+    auto& generator = generators.emplace_back();
+    for (std::size_t i = 0; i < chart.dimension(); ++i)
+      generator += direction[i] * space.base(i);
+  }
+  Bounded_affine_space<ScalarT, AmbientDim> result(
+    Affine_space<ScalarT, AmbientDim>(chart.to_ambient(solution->point),
+                                      std::move(generators),
+                                      std::move(compare)));
+  restrict_constraints(chart, result);
+  return result;
+}
+
+} // namespace detail
+
+// Clips in the chart of the argument of lower dimension: the equations of the
+// other flat are solved in its local coordinates, so the unbounded
+// intersection is never formed in ambient coordinates, and coplanar polygons
+// are clipped in the plane of the first one.
+template<class ScalarT, unsigned AmbientDim, class F>
+std::optional<Bounded_affine_space<ScalarT, AmbientDim>>
+intersection(const Bounded_affine_space<ScalarT, AmbientDim>& lhs,
+             const Bounded_affine_space<ScalarT, AmbientDim>& rhs,
+             F compare)
+{
+  if (rhs.dimension() < lhs.dimension())
+    return intersection(rhs, lhs, std::move(compare));
+  auto result = detail::restrict_chart(lhs, rhs.affine_space(), compare);
+  if (!result)
+    return std::nullopt;
+  detail::restrict_constraints(rhs, *result);
+  if (result->empty(std::move(compare)))
+    return std::nullopt;
+  return result;
+}
+
+template<class ScalarT, unsigned AmbientDim, class F>
+std::optional<Bounded_affine_space<ScalarT, AmbientDim>>
+intersection(const Bounded_affine_space<ScalarT, AmbientDim>& lhs,
+             const Affine_space<ScalarT, AmbientDim>& rhs,
+             F compare)
+{
+  return intersection(
+    lhs, Bounded_affine_space<ScalarT, AmbientDim>(rhs), std::move(compare));
+}
+
+template<class ScalarT, unsigned AmbientDim, class F>
+std::optional<Bounded_affine_space<ScalarT, AmbientDim>>
+intersection(const Affine_space<ScalarT, AmbientDim>& lhs,
+             const Bounded_affine_space<ScalarT, AmbientDim>& rhs,
+             F compare)
+{
+  return intersection(
+    Bounded_affine_space<ScalarT, AmbientDim>(lhs), rhs, std::move(compare));
+}
+
+} // namespace affine
@@ -0,0 +1,189 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "affine/affine_space.h"
+#include "affine/detail/affine_detail.h"
+#include "affine/detail/capd.h"
+
+namespace affine {
+
+namespace detail {
+
+inline void
+hash_combine(std::size_t& seed, std::size_t value)
+{
+  seed ^= value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+}
+
+template<class T, class F>
+std::vector<T>
+reduced_row_echelon_form(std::vector<T> rows, F compare)
+{
+  const auto dim = static_cast<std::size_t>(T().dimension());
+  std::size_t rank = 0;
+  for (std::size_t col = 0; col < dim && rank < rows.size(); ++col) {
+    auto pivot = rank;
+    for (auto r = rank + 1; r < rows.size(); ++r)
+      if (capd::abs(rows[r][col]) > capd::abs(rows[pivot][col]))
+        pivot = r;
+    if (compare(rows[pivot][col], 0))
+      continue;
+    std::swap(rows[rank], rows[pivot]);
+    const auto pivot_value = rows[rank][col];
+    rows[rank] /= pivot_value;
+    for (std::size_t r = 0; r < rows.size(); ++r) {
+      if (r == rank)
+        continue;
+      const auto factor = rows[r][col];
+      rows[r] -= factor * rows[rank];
+    }
+    ++rank;
+  }
+  rows.resize(rank);
+  return rows;
+}
+
+template<class T>
+T
+min_norm_point(T point, const std::vector<T>& base)
+{
+  const auto origin = point;
+  for (auto&& v : base)
+    point -= (v * origin) * v;
+  return point;
+}
+
+} // namespace detail
+
+// Representation of 'affine_space' that does not depend on how it was
+// constructed: the point nearest to the origin and the orthonormalized
+// reduced row echelon form of the base.
+template<class ScalarT, unsigned AmbientDim, class F>
+Affine_space<ScalarT, AmbientDim>
+canonical(const Affine_space<ScalarT, AmbientDim>& affine_space, F compare)
+{
+  auto rows =
+    detail::reduced_row_echelon_form(affine_space.base(), std::move(compare));
+  for (std::size_t i = 0; i < rows.size(); ++i) {
+    for (std::size_t j = 0; j < i; ++j)
+      rows[i] -= (rows[i] * rows[j]) * rows[j];
+    rows[i].normalize();
+  }
+  return Affine_space<ScalarT, AmbientDim>(
+    orthonormal,
+    detail::min_norm_point(affine_space.point(), affine_space.base()),
+    std::move(rows));
+}
+
+template<class ScalarT, unsigned AmbientDim, class F>
+bool
+equivalent(const Affine_space<ScalarT, AmbientDim>& lhs,
+           const Affine_space<ScalarT, AmbientDim>& rhs,
+           F compare)
+{
+  if (lhs.dimension() != rhs.dimension())
+    return false;
+  if (!rhs.element(lhs.point(), compare))
+    return false;
+  for (auto&& v : lhs.base())
+    if (!rhs.element(lhs.point() + v, compare))
+      return false;
+  return true;
+}
+
+namespace detail {
+
+// Canonical coordinates of 'affine_space' in units of 'resolution': those of
+// the point nearest to the origin followed by those of the reduced row
+// echelon form of the base.
+template<class ScalarT, unsigned AmbientDim, class F>
+std::vector<double>
+scaled_canonical_coordinates(
+  const Affine_space<ScalarT, AmbientDim>& affine_space,
+  double resolution,
+  F compare)
+{
+  std::vector<double> result;
+  const auto point = min_norm_point(affine_space.point(), affine_space.base());
+  for (std::size_t i = 0; i < AmbientDim; ++i)
+    result.push_back(representative(point[i]) / resolution);
+  for (auto&& v :
+       reduced_row_echelon_form(affine_space.base(), std::move(compare)))
+    for (std::size_t i = 0; i < AmbientDim; ++i)
+      result.push_back(representative(v[i]) / resolution);
+  return result;
+}
+
+// The cell index is hashed as a double, which unlike a conversion to an
+// integer stays well defined for any magnitude; adding 0 turns -0 into 0.
+inline std::size_t
+hash_cells(std::size_t dimension, const std::vector<double>& cells)
+{
+  std::size_t seed = dimension;
+  for (auto cell : cells)
+    hash_combine(seed, std::hash<double>{}(cell + 0.0));
+  return seed;
+}
+
+// Coordinates farther than this fraction of a cell from the cell's centre
+// are also looked up in the neighbouring cell they are closer to.
+inline constexpr double neighbour_margin = 3.0 / 8.0;
+
+} // namespace detail
+
+// Hash of the canonical form quantized to a grid of the given resolution.
+// Coordinates are rounded to the nearest cell, so the values canonical forms
+// usually take (0, +-1 and other multiples of 'resolution') lie at cell
+// centres, far from the boundaries where rounding noise would flip the cell.
+template<class ScalarT, unsigned AmbientDim, class F>
+std::size_t
+hash_value(const Affine_space<ScalarT, AmbientDim>& affine_space,
+           double resolution,
+           F compare)
+{
+  auto cells = detail::scaled_canonical_coordinates(
+    affine_space, resolution, std::move(compare));
+  for (auto& cell : cells)
+    cell = std::round(cell);
+  return detail::hash_cells(affine_space.dimension(), cells);
+}
+
+// Every hash a flat equivalent to 'affine_space' may have, hash_value of
+// 'affine_space' first. Canonical coordinates within an eighth of a cell of a
+// cell boundary contribute both cells, so this covers every flat whose
+// canonical coordinates differ from those of 'affine_space' by less than
+// resolution / 8. Their number doubles with every such coordinate; it stays
+// small when 'resolution' is large compared to the tolerance of 'compare'.
+template<class ScalarT, unsigned AmbientDim, class F>
+std::vector<std::size_t>
+hash_values(const Affine_space<ScalarT, AmbientDim>& affine_space,
+            double resolution,
+            F compare)
+{
+  const auto scaled = detail::scaled_canonical_coordinates(
+    affine_space, resolution, std::move(compare));
+  std::vector<std::vector<double>> cells(1);
+  for (auto x : scaled) {
+    const auto cell = std::round(x);
+    const auto count = cells.size();
+    if (std::abs(x - cell) > detail::neighbour_margin)
+      for (std::size_t i = 0; i < count; ++i) {
+        cells.push_back(cells[i]);
+        cells.back().push_back(x > cell ? cell + 1 : cell - 1);
+      }
+    for (std::size_t i = 0; i < count; ++i)
+      cells[i].push_back(cell);
+  }
+  std::vector<std::size_t> result;
+  result.reserve(cells.size());
+  for (auto&& c : cells)
+    result.push_back(detail::hash_cells(affine_space.dimension(), c));
+  return result;
+}
+
+} // namespace affine
@@ -0,0 +1,294 @@
+#pragma once
+
+#include <array>
+#include <bitset>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "affine/affine_fwd.h"
+#include "affine/affine_space.h"
+#include "affine/canonical.h"
+#include "affine/detail/affine_detail.h"
+#include "affine/detail/capd.h"
+
+namespace affine {
+
+namespace detail {
+
+// Gauss-Jordan elimination with complete pivoting over the first 'columns'
+// entries of each row; further entries are carried along. Returns the pivot
+// column of each leading row, those rows being reduced so that every pivot
+// column is a unit vector. Rows past the rank are left with entries that
+// 'compare' accepts as zero.
+template<class T, std::size_t Columns, class F>
+std::vector<std::size_t>
+gauss_jordan(std::vector<std::array<T, Columns>>& rows,
+             std::size_t columns,
+             F compare)
+{
+  std::vector<std::size_t> pivots;
+  for (std::size_t rank = 0; rank < rows.size(); ++rank) {
+    std::size_t pivot_row = rank;
+    std::size_t pivot_column = 0;
+    T largest{ 0 };
+    for (auto r = rank; r < rows.size(); ++r)
+      for (std::size_t c = 0; c < columns; ++c)
+        if (std::abs(rows[r][c]) > largest) {
+          largest = std::abs(rows[r][c]);
+          pivot_row = r;
+          pivot_column = c;
+        }
+    if (compare(largest, 0))
+      break;
+    std::swap(rows[rank], rows[pivot_row]);
+    const auto pivot = rows[rank][pivot_column];
+    for (auto& x : rows[rank])
+      x /= pivot;
+    for (std::size_t r = 0; r < rows.size(); ++r) {
+      const auto factor = rows[r][pivot_column];
+      if (r == rank || factor == 0)
+        continue;
+      for (std::size_t c = 0; c < Columns; ++c)
+        rows[r][c] -= factor * rows[rank][c];
+    }
+    pivots.push_back(pivot_column);
+  }
+  return pivots;
+}
+
+} // namespace detail
+
+// Flat stored in an affine chart of the Grassmannian. The k parameter
+// columns, chosen by complete pivoting, determine the remaining N - k
+// dependent coordinates: x[dependent[j]] == sum_i a(i, j) *
+// x[parameter[i]] + c(j). That is (k + 1) * (N - k) scalars in a fixed
+// array, optionally quantized to a narrower StorageT, instead of a point, a
+// heap allocated base of k * N scalars and its vector header. Computations
+// are carried out in ScalarT.
+template<class ScalarT, unsigned AmbientDim, class StorageT>
+  requires std::floating_point<ScalarT> && std::floating_point<StorageT>
+class Compact_affine_space
+{
+public:
+  using Scalar = ScalarT;
+  using Storage = StorageT;
+  using Point = detail::Point<ScalarT, AmbientDim>;
+  using Mask = std::bitset<AmbientDim>;
+  using Aff_space = Affine_space<ScalarT, AmbientDim>;
+  // Coefficients of an equation followed by its right hand side.
+  using Equation = std::array<ScalarT, AmbientDim + 1>;
+
+  static constexpr std::size_t capacity =
+    (AmbientDim + 1) * (AmbientDim + 1) / 4;
+
+  Compact_affine_space() = default;
+
+  template<class F>
+  explicit Compact_affine_space(const Aff_space& affine_space, F compare)
+  {
+    std::vector<Equation> rows;
+    for (auto&& v : affine_space.base()) {
+      rows.emplace_back();
+      for (std::size_t i = 0; i < AmbientDim; ++i)
+        rows.back()[i] = v[i];
+    }
+    const auto pivots = detail::gauss_jordan(rows, AmbientDim, compare);
+    for (auto p : pivots)
+      parameters_.set(p);
+    const auto columns = split_columns();
+    const auto k = dimension();
+    for (std::size_t r = 0; r < k; ++r) {
+      std::size_t i = 0;
+      while (columns.parameter[i] != pivots[r])
+        ++i;
+      for (std::size_t j = 0; j < AmbientDim - k; ++j)
+        values_[i * (AmbientDim - k) + j] =
+          static_cast<StorageT>(rows[r][columns.dependent[j]]);
+    }
+    const auto& point = affine_space.point();
+    for (std::size_t j = 0; j < AmbientDim - k; ++j) {
+      auto value = point[columns.dependent[j]];
+      for (std::size_t i = 0; i < k; ++i)
+        value -= a(i, j) * point[columns.parameter[i]];
+      values_[k * (AmbientDim - k) + j] = static_cast<StorageT>(value);
+    }
+  }
+
+  // Solution set of the given equations, std::nullopt if they are
+  // inconsistent.
+  template<class F>
+  static std::optional<Compact_affine_space> solution_set(
+    std::vector<Equation> equations,
+    F compare)
+  {
+    for (auto& e : equations) {
+      Scalar squared_norm{ 0 };
+      for (std::size_t i = 0; i < AmbientDim; ++i)
+        squared_norm += e[i] * e[i];
+      const auto norm = std::sqrt(squared_norm);
+      if (!compare(norm, 0))
+        for (auto& x : e)
+          x /= norm;
+    }
+    const auto pivots = detail::gauss_jordan(equations, AmbientDim, compare);
+    for (auto r = pivots.size(); r < equations.size(); ++r)
+      if (!compare(equations[r][AmbientDim], 0))
+        return std::nullopt;
+    Compact_affine_space result;
+    result.parameters_.set();
+    for (auto p : pivots)
+      result.parameters_.reset(p);
+    const auto columns = result.split_columns();
+    const auto k = result.dimension();
+    for (std::size_t j = 0; j < AmbientDim - k; ++j) {
+      std::size_t r = 0;
+      while (pivots[r] != columns.dependent[j])
+        ++r;
+      for (std::size_t i = 0; i < k; ++i)
+        result.values_[i * (AmbientDim - k) + j] =
+          static_cast<StorageT>(-equations[r][columns.parameter[i]]);
+      result.values_[k * (AmbientDim - k) + j] =
+        static_cast<StorageT>(equations[r][AmbientDim]);
+    }
+    return result;
+  }
+
+  constexpr std::size_t ambient_dimension() const { return AmbientDim; }
+
+  std::size_t dimension() const { return parameters_.count(); }
+
+  const Mask& parameters() const { return parameters_; }
+
+  // The N - k equations x[dependent[j]] - sum_i a(i, j) * x[parameter[i]] ==
+  // c(j) cutting out the flat.
+  std::vector<Equation> equations() const
+  {
+    const auto columns = split_columns();
+    const auto k = dimension();
+    std::vector<Equation> result(AmbientDim - k);
+    for (std::size_t j = 0; j < AmbientDim - k; ++j) {
+      result[j][columns.dependent[j]] = 1;
+      for (std::size_t i = 0; i < k; ++i)
+        result[j][columns.parameter[i]] = -a(i, j);
+      result[j][AmbientDim] = c(j);
+    }
+    return result;
+  }
+
+  // The squared distance is r^T (I + A^T A)^-1 r for the residual r of the
+  // equations, evaluated through the Cholesky factor of I + A^T A.
+  Scalar distance(const Point& point) const
+  {
+    const auto columns = split_columns();
+    const auto k = dimension();
+    const auto n = AmbientDim - k;
+    std::array<Scalar, AmbientDim> r{};
+    for (std::size_t j = 0; j < n; ++j) {
+      r[j] = point[columns.dependent[j]] - c(j);
+      for (std::size_t i = 0; i < k; ++i)
+        r[j] -= a(i, j) * point[columns.parameter[i]];
+    }
+    std::array<Scalar, AmbientDim * AmbientDim> m{};
+    for (std::size_t j = 0; j < n; ++j)
+      for (std::size_t l = 0; l <= j; ++l) {
+        Scalar value = j == l ? 1 : 0;
+        for (std::size_t i = 0; i < k; ++i)
+          value += a(i, j) * a(i, l);
+        for (std::size_t p = 0; p < l; ++p)
+          value -= m[j * n + p] * m[l * n + p];
+        m[j * n + l] = j == l ? std::sqrt(value) : value / m[l * n + l];
+      }
+    auto z = r;
+    for (std::size_t j = 0; j < n; ++j) {
+      for (std::size_t p = 0; p < j; ++p)
+        z[j] -= m[j * n + p] * z[p];
+      z[j] /= m[j * n + j];
+    }
+    Scalar result{ 0 };
+    for (std::size_t j = 0; j < n; ++j)
+      result += z[j] * z[j];
+    return std::sqrt(result);
+  }
+
+  template<class F>
+  bool element(const Point& point, F compare) const
+  {
+    return compare(distance(point), 0);
+  }
+
+  // Orthonormal form with the point of minimal norm.
+  template<class F>
+  Aff_space to_affine_space(F compare) const
+  {
+    const auto columns = split_columns();
+    const auto k = dimension();
+    std::vector<Point> base(k);
+    for (std::size_t i = 0; i < k; ++i) {
+      base[i][columns.parameter[i]] = 1;
+      for (std::size_t j = 0; j < AmbientDim - k; ++j)
+        base[i][columns.dependent[j]] = a(i, j);
+    }
+    Point point{};
+    for (std::size_t j = 0; j < AmbientDim - k; ++j)
+      point[columns.dependent[j]] = c(j);
+    const auto dim =
+      detail::gram_schmidt_orthonormalization(base, std::move(compare));
+    base.resize(dim);
+    auto min_norm_point = detail::min_norm_point(point, base);
+    return Aff_space(orthonormal, std::move(min_norm_point), std::move(base));
+  }
+
+private:
+  struct Columns
+  {
+    std::array<std::size_t, AmbientDim> parameter;
+    std::array<std::size_t, AmbientDim> dependent;
+  };
+
+  Columns split_columns() const
+  {
+    Columns result{};
+    std::size_t i = 0;
+    std::size_t j = 0;
+    for (std::size_t col = 0; col < AmbientDim; ++col)
+      if (parameters_[col])
+        result.parameter[i++] = col;
+      else
+        result.dependent[j++] = col;
+    return result;
+  }
+
+  Scalar a(std::size_t i, std::size_t j) const
+  {
+    return values_[i * (AmbientDim - dimension()) + j];
+  }
+
+  Scalar c(std::size_t j) const
+  {
+    const auto k = dimension();
+    return values_[k * (AmbientDim - k) + j];
+  }
+
+  Mask parameters_{};
+  std::array<StorageT, capacity> values_{};
+};
+
+// Intersects the equations of both flats without expanding either of them.
+template<class ScalarT, unsigned AmbientDim, class StorageT, class F>
+std::optional<Compact_affine_space<ScalarT, AmbientDim, StorageT>>
+intersection(const Compact_affine_space<ScalarT, AmbientDim, StorageT>& lhs,
+             const Compact_affine_space<ScalarT, AmbientDim, StorageT>& rhs,
+             F compare)
+{
+  auto equations = lhs.equations();
+  for (auto&& e : rhs.equations())
+    equations.push_back(e);
+  return Compact_affine_space<ScalarT, AmbientDim, StorageT>::solution_set(
+    std::move(equations), std::move(compare));
+}
+
+} // namespace affine
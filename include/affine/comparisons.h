@@ -3,10 +3,8 @@
 #include <cmath>
 #include <stdexcept>
 
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Woverloaded-virtual"
-#include <capd/capdlib.h>
-#pragma GCC diagnostic pop
+#include "affine/affine_fwd.h"
+#include "affine/detail/capd.h"
 
 namespace affine {
 
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <bitset>
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+#include "affine/affine_fwd.h"
+#include "affine/affine_space.h"
+#include "affine/detail/capd.h"
+#include "affine/intersection.h"
+#include "affine/detail/affine_detail.h"
+
+namespace affine {
+
+// Axis-aligned flat { x : x[i] == values[i] for every fixed coordinate i }.
+template<class ScalarT, unsigned AmbientDim>
+class Coordinate_space
+{
+public:
+  using Scalar = ScalarT;
+  using Point = detail::Point<ScalarT, AmbientDim>;
+  using Mask = std::bitset<AmbientDim>;
+  using Aff_space = Affine_space<ScalarT, AmbientDim>;
+
+  Coordinate_space() = default;
+
+  Coordinate_space(const Mask& fixed, const Point& values)
+    : fixed_(fixed)
+  {
+    for (std::size_t i = 0; i < AmbientDim; ++i)
+      if (fixed_[i])
+        values_[i] = values[i];
+  }
+
+  // Detects whether 'affine_space' is axis-aligned from the diagonal of its
+  // orthogonal projector, whose entries are 1 for free and 0 for fixed
+  // coordinates exactly when it is.
+  template<class F>
+  static std::optional<Coordinate_space> from(const Aff_space& affine_space,
+                                              F compare)
+  {
+    Mask fixed;
+    for (std::size_t i = 0; i < AmbientDim; ++i) {
+      Scalar diagonal{ 0 };
+      for (auto&& v : affine_space.base())
+        diagonal += v[i] * v[i];
+      if (compare(diagonal, 0))
+        fixed.set(i);
+      else if (!compare(diagonal, 1))
+        return std::nullopt;
+    }
+    return Coordinate_space(fixed, affine_space.point());
+  }
+
+  constexpr std::size_t ambient_dimension() const { return AmbientDim; }
+
+  std::size_t dimension() const { return AmbientDim - fixed_.count(); }
+
+  const Mask& fixed() const { return fixed_; }
+
+  const Point& values() const { return values_; }
+
+  template<class F>
+  bool element(const Point& point, F compare) const
+  {
+    Point diff{};
+    for (std::size_t i = 0; i < AmbientDim; ++i)
+      if (fixed_[i])
+        diff[i] = point[i] - values_[i];
+    return compare(capd::vectalg::euclNorm(diff), 0);
+  }
+
+  Point projection(Point point) const
+  {
+    for (std::size_t i = 0; i < AmbientDim; ++i)
+      if (fixed_[i])
+        point[i] = values_[i];
+    return point;
+  }
+
+  Aff_space to_affine_space() const
+  {
+    std::vector<Point> base;
+    for (std::size_t i = 0; i < AmbientDim; ++i) {
+      if (!fixed_[i]) {
+        base.emplace_back();
+        base.back()[i] = 1;
+      }
+    }
+    return Aff_space(orthonormal, values_, std::move(base));
+  }
+
+private:
+  Mask fixed_{ Mask().set() };
+  Point values_{};
+};
+
+template<class ScalarT, unsigned AmbientDim, class F>
+std::optional<Coordinate_space<ScalarT, AmbientDim>>
+intersection(const Coordinate_space<ScalarT, AmbientDim>& lhs,
+             const Coordinate_space<ScalarT, AmbientDim>& rhs,
+             F compare)
+{
+  const auto common = lhs.fixed() & rhs.fixed();
+  detail::Point<ScalarT, AmbientDim> diff{};
+  auto values = lhs.values();
+  for (std::size_t i = 0; i < AmbientDim; ++i) {
+    if (common[i])
+      diff[i] = lhs.values()[i] - rhs.values()[i];
+    else if (rhs.fixed()[i])
+      values[i] = rhs.values()[i];
+  }
+  if (!compare(capd::vectalg::euclNorm(diff), 0))
+    return std::nullopt;
+  return Coordinate_space<ScalarT, AmbientDim>(lhs.fixed() | rhs.fixed(),
+                                               values);
+}
+
+template<class ScalarT, unsigned AmbientDim, class F>
+std::optional<Affine_space<ScalarT, AmbientDim>>
+intersection(const Coordinate_space<ScalarT, AmbientDim>& lhs,
+             const Affine_space<ScalarT, AmbientDim>& rhs,
+             F compare)
+{
+  return intersection(lhs.to_affine_space(), rhs, std::move(compare));
+}
+
+template<class ScalarT, unsigned AmbientDim, class F>
+std::optional<Affine_space<ScalarT, AmbientDim>>
+intersection(const Affine_space<ScalarT, AmbientDim>& lhs,
+             const Coordinate_space<ScalarT, AmbientDim>& rhs,
+             F compare)
+{
+  return intersection(lhs, rhs.to_affine_space(), std::move(compare));
+}
+
+} // namespace affine
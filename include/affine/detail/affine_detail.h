@@ -1,13 +1,15 @@
 #pragma once
 
 #include <algorithm>
+#include <concepts>
+#include <cstddef>
 #include <ranges>
 #include <stdexcept>
+#include <type_traits>
+#include <vector>
 
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Woverloaded-virtual"
-#include <capd/capdlib.h>
-#pragma GCC diagnostic pop
+#include "affine/accumulation.h"
+#include "affine/detail/capd.h"
 
 namespace affine {
 
@@ -16,39 +18,170 @@ namespace detail {
 template<class T, int N>
 using Point = capd::vectalg::Vector<T, N>;
 
+template<class T, int Rows, int Columns>
+using Matrix = capd::vectalg::Matrix<T, Rows, Columns>;
+
+template<class AccT, class T>
+struct Rebind;
+
+template<class AccT, class ScalarT, auto N>
+struct Rebind<AccT, capd::vectalg::Vector<ScalarT, N>>
+{
+  using type = capd::vectalg::Vector<AccT, N>;
+};
+
+template<class T>
+struct Is_point : std::false_type
+{};
+
+template<class ScalarT, auto N>
+struct Is_point<capd::vectalg::Vector<ScalarT, N>> : std::true_type
+{
+  using scalar = ScalarT;
+  static constexpr unsigned ambient_dim = N;
+};
+
+template<class AccT, class T>
+using rebind_t = typename Rebind<AccT, std::remove_cvref_t<T>>::type;
+
+template<std::floating_point T>
+double
+representative(T x)
+{
+  return static_cast<double>(x);
+}
+
+template<class T, class R>
+double
+representative(const capd::intervals::Interval<T, R>& x)
+{
+  return static_cast<double>((x.leftBound() + x.rightBound()) / 2);
+}
+
+template<class AccT, class T>
+rebind_t<AccT, T>
+rebind(const T& v)
+{
+  rebind_t<AccT, T> result;
+  for (std::size_t i = 0; i < static_cast<std::size_t>(v.dimension()); ++i)
+    result[i] = static_cast<AccT>(v[i]);
+  return result;
+}
+
+template<class AccT, class T, class U>
+AccT
+dot(const T& lhs, const U& rhs)
+{
+  AccT result{ 0 };
+  for (std::size_t i = 0; i < static_cast<std::size_t>(lhs.dimension()); ++i)
+    result += static_cast<AccT>(lhs[i]) * static_cast<AccT>(rhs[i]);
+  return result;
+}
+
 template<std::ranges::forward_range R, class F>
 std::ptrdiff_t
 gram_schmidt_orthonormalization(R&& vectors, F compare)
 {
   namespace rs = std::ranges;
-  for (auto outer_iter = rs::begin(vectors); outer_iter != rs::end(vectors);
-       ++outer_iter) {
-    auto& v_i = *outer_iter;
-    const auto max_element = std::ranges::max_element(
-      std::ranges::subrange(outer_iter, rs::end(vectors)), {}, [](auto&& x) {
-        return x * x;
-      });
-    rs::iter_swap(max_element, outer_iter);
-    if (compare(capd::vectalg::euclNorm(v_i), 0))
-      return rs::distance(rs::begin(vectors), outer_iter);
-    v_i.normalize();
-    for (auto inner_iter = rs::next(outer_iter); inner_iter != rs::end(vectors);
-         ++inner_iter) {
-      auto& v_j = *inner_iter;
-      v_j -= (v_j * v_i) * v_i;
+  using Scalar = typename rs::range_value_t<R>::ScalarType;
+  using Acc = accumulation_t<Scalar>;
+  if constexpr (!std::same_as<Acc, Scalar>) {
+    std::vector<rebind_t<Acc, rs::range_value_t<R>>> accumulated;
+    for (auto&& v : vectors)
+      accumulated.push_back(rebind<Acc>(v));
+    const auto dim =
+      gram_schmidt_orthonormalization(accumulated, std::move(compare));
+    auto iter = rs::begin(vectors);
+    for (auto&& v : accumulated)
+      *iter++ = rebind<Scalar>(v);
+    return dim;
+  } else {
+    for (auto outer_iter = rs::begin(vectors); outer_iter != rs::end(vectors);
+         ++outer_iter) {
+      auto& v_i = *outer_iter;
+      const auto max_element = std::ranges::max_element(
+        std::ranges::subrange(outer_iter, rs::end(vectors)), {}, [](auto&& x) {
+          return x * x;
+        });
+      rs::iter_swap(max_element, outer_iter);
+      if (compare(capd::vectalg::euclNorm(v_i), 0))
+        return rs::distance(rs::begin(vectors), outer_iter);
+      v_i.normalize();
+      for (auto inner_iter = rs::next(outer_iter);
+           inner_iter != rs::end(vectors);
+           ++inner_iter) {
+        auto& v_j = *inner_iter;
+        v_j -= (v_j * v_i) * v_i;
+      }
     }
+    return rs::ssize(vectors);
+  }
+}
+
+template<class T, class F>
+std::vector<T>
+orthonormal_complement(const std::vector<T>& vectors, F compare)
+{
+  const auto dim = static_cast<std::size_t>(T().dimension());
+  std::vector<T> complement(dim);
+  for (std::size_t i = 0; i < dim; ++i) {
+    auto& e_i = complement[i];
+    e_i[i] = 1;
+    for (auto&& v : vectors)
+      e_i -= v[i] * v;
   }
-  return rs::ssize(vectors);
+  const auto complement_dim =
+    gram_schmidt_orthonormalization(complement, std::move(compare));
+  complement.resize(std::min(static_cast<std::size_t>(complement_dim),
+                             dim - std::min(dim, vectors.size())));
+  return complement;
+}
+
+// Whether map^T map == s^2 I for some s != 0, i.e. whether 'map' is an
+// orthogonal map scaled by s. Such a map takes orthonormal vectors to
+// orthogonal vectors of norm s.
+template<class M, class F>
+bool
+conformal(const M& map, F compare)
+{
+  using T = std::remove_cvref_t<decltype(map[0][0])>;
+  const auto dim = static_cast<std::size_t>(map.numberOfRows());
+  T scale{ 0 };
+  for (std::size_t i = 0; i < dim; ++i)
+    scale += map[i][0] * map[i][0];
+  if (compare(scale, 0))
+    return false;
+  for (std::size_t j = 0; j < dim; ++j)
+    for (std::size_t l = 0; l <= j; ++l) {
+      T product{ 0 };
+      for (std::size_t i = 0; i < dim; ++i)
+        product += map[i][j] * map[i][l];
+      if (!compare(product / scale, j == l ? 1 : 0))
+        return false;
+    }
+  return true;
 }
 
 template<class T, std::ranges::input_range R, class F>
 bool
 in_range_of_orthogonal_vectors(T point, R&& vectors, F compare)
 {
-  for (auto&& v : vectors)
-    point -= (v * point) * v;
-  const auto norm = capd::vectalg::euclNorm(point);
-  return compare(norm, 0);
+  using Scalar = typename T::ScalarType;
+  using Acc = accumulation_t<Scalar>;
+  if constexpr (!std::same_as<Acc, Scalar>) {
+    auto residual = rebind<Acc>(point);
+    for (auto&& v : vectors) {
+      const auto prod = dot<Acc>(v, residual);
+      for (std::size_t i = 0; i < static_cast<std::size_t>(v.dimension()); ++i)
+        residual[i] -= prod * static_cast<Acc>(v[i]);
+    }
+    return compare(capd::vectalg::euclNorm(residual), 0);
+  } else {
+    for (auto&& v : vectors)
+      point -= (v * point) * v;
+    const auto norm = capd::vectalg::euclNorm(point);
+    return compare(norm, 0);
+  }
 }
 
 template<class ScalarT>
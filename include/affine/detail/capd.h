@@ -0,0 +1,13 @@
+#pragma once
+
+// The parts of CAPD the library uses: intervals and the vector and matrix
+// algebra. <capd/capdlib.h> adds the maps, differential algebra, dynamical
+// systems and Poincare maps on top of them, which none of the headers need
+// and which dominate the time spent parsing it.
+
+// skips -Woverloaded-virtual warnings for capd library
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Woverloaded-virtual"
+#include <capd/intervals/lib.h>
+#include <capd/vectalg/lib.h>
+#pragma GCC diagnostic pop
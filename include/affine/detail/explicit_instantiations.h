@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+#include <initializer_list>
+#include <optional>
+#include <vector>
+
+#include "affine/affine_space.h"
+#include "affine/comparisons.h"
+#include "affine/detail/capd.h"
+#include "affine/intersection.h"
+
+// Instantiations compiled into the affine library. Expanded with 'extern' in
+// every translation unit linking the library (AFFINE_EXTERN_TEMPLATES) and
+// without it in src/affine.cpp.
+
+#define AFFINE_INSTANTIATE(EXTERN, SCALAR, DIM, COMPARE)                       \
+  EXTERN template class affine::Affine_space<SCALAR, DIM>;                     \
+  EXTERN template affine::Affine_space<SCALAR, DIM>::Affine_space(             \
+    affine::Affine_space<SCALAR, DIM>::Point,                                  \
+    std::vector<affine::Affine_space<SCALAR, DIM>::Point>,                     \
+    COMPARE);                                                                  \
+  EXTERN template bool affine::Affine_space<SCALAR, DIM>::element<COMPARE>(    \
+    const affine::Affine_space<SCALAR, DIM>::Point&, COMPARE) const;           \
+  EXTERN template affine::Affine_space<SCALAR, DIM>                            \
+  affine::Affine_space<SCALAR, DIM>::spanning_space<COMPARE>(                  \
+    std::initializer_list<affine::Affine_space<SCALAR, DIM>::Point>, COMPARE); \
+  EXTERN template affine::Affine_space<SCALAR, DIM>                            \
+  affine::Affine_space<SCALAR, DIM>::spanning_space<COMPARE>(                  \
+    std::vector<affine::Affine_space<SCALAR, DIM>::Point>&&, COMPARE);         \
+  EXTERN template std::ptrdiff_t                                               \
+  affine::detail::gram_schmidt_orthonormalization<                             \
+    std::vector<affine::Affine_space<SCALAR, DIM>::Point>&,                    \
+    COMPARE>(std::vector<affine::Affine_space<SCALAR, DIM>::Point>&, COMPARE); \
+  EXTERN template std::optional<affine::Affine_space<SCALAR, DIM>>             \
+  affine::intersection<SCALAR, DIM, COMPARE>(                                  \
+    const affine::Affine_space<SCALAR, DIM>&,                                  \
+    const affine::Affine_space<SCALAR, DIM>&,                                  \
+    COMPARE);                                                                  \
+  EXTERN template std::optional<affine::Affine_space<SCALAR, DIM>>             \
+  affine::intersection<SCALAR, DIM, COMPARE>(                                  \
+    affine::Affine_space<SCALAR, DIM>&&,                                       \
+    const affine::Affine_space<SCALAR, DIM>&,                                  \
+    COMPARE);                                                                  \
+  EXTERN template std::optional<affine::Affine_space<SCALAR, DIM>>             \
+  affine::intersection<SCALAR, DIM, COMPARE>(                                  \
+    const affine::Affine_space<SCALAR, DIM>&,                                  \
+    affine::Affine_space<SCALAR, DIM>&&,                                       \
+    COMPARE);                                                                  \
+  EXTERN template std::optional<affine::Affine_space<SCALAR, DIM>>             \
+  affine::intersection<SCALAR, DIM, COMPARE>(                                  \
+    affine::Affine_space<SCALAR, DIM>&&,                                       \
+    affine::Affine_space<SCALAR, DIM>&&,                                       \
+    COMPARE);
+
+#define AFFINE_INSTANTIATE_ALL(EXTERN)                                         \
+  AFFINE_INSTANTIATE(EXTERN, double, 1, affine::Equal_to_precision)            \
+  AFFINE_INSTANTIATE(EXTERN, double, 2, affine::Equal_to_precision)            \
+  AFFINE_INSTANTIATE(EXTERN, double, 3, affine::Equal_to_precision)            \
+  AFFINE_INSTANTIATE(EXTERN, double, 4, affine::Equal_to_precision)            \
+  AFFINE_INSTANTIATE(EXTERN, capd::DInterval, 1, affine::IApprox_equal)        \
+  AFFINE_INSTANTIATE(EXTERN, capd::DInterval, 2, affine::IApprox_equal)        \
+  AFFINE_INSTANTIATE(EXTERN, capd::DInterval, 3, affine::IApprox_equal)        \
+  AFFINE_INSTANTIATE(EXTERN, capd::DInterval, 4, affine::IApprox_equal)
+
+#ifdef AFFINE_EXTERN_TEMPLATES
+AFFINE_INSTANTIATE_ALL(extern)
+#endif
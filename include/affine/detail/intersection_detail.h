@@ -1,81 +1,132 @@
 #pragma once
 
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
 #include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
 
 #include "affine/affine_space.h"
 #include "affine/detail/affine_detail.h"
-
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Woverloaded-virtual"
-#include <capd/capdlib.h>
-#pragma GCC diagnostic pop
+#include "affine/detail/capd.h"
 
 namespace affine {
 
 namespace detail {
 
-template<class ScalarT, unsigned AmbientDim, class F>
+// The kernels below take their first operand by forwarding reference, so
+// that an expiring operand can hand its storage over to the result.
+template<class Lhs, class ScalarT, unsigned AmbientDim>
+concept Operand =
+  std::same_as<std::remove_cvref_t<Lhs>, Affine_space<ScalarT, AmbientDim>>;
+
+// Intersection of 'lhs' with the hyperplane { x : normal * x == offset },
+// 'normal' being a unit vector.
+template<class Lhs, class ScalarT, unsigned AmbientDim, class F>
+  requires Operand<Lhs, ScalarT, AmbientDim>
+std::optional<Affine_space<ScalarT, AmbientDim>>
+space_with_hyperplane_intersection(Lhs&& lhs,
+                                   const Point<ScalarT, AmbientDim>& normal,
+                                   const ScalarT& offset,
+                                   F compare)
+{
+  Point<ScalarT, AmbientDim> u{};
+  for (auto&& v : lhs.base())
+    u += (normal * v) * v;
+  const auto norm = capd::vectalg::euclNorm(u);
+  const auto distance = offset - normal * lhs.point();
+  if (compare(norm, 0)) {
+    if (compare(distance, 0))
+      return std::forward<Lhs>(lhs);
+    else
+      return std::nullopt;
+  }
+  u /= norm;
+  const auto dimension = lhs.dimension();
+  auto point = lhs.point() + u * (distance / norm);
+  auto base = std::forward<Lhs>(lhs).base();
+  for (auto& v : base)
+    v -= (v * u) * u;
+  const auto dim = gram_schmidt_orthonormalization(base, compare);
+  base.resize(std::min(static_cast<std::size_t>(dim), dimension - 1));
+  return Affine_space<ScalarT, AmbientDim>(
+    affine::orthonormal, std::move(point), std::move(base));
+}
+
+template<class Lhs, class ScalarT, unsigned AmbientDim, class F>
+  requires Operand<Lhs, ScalarT, AmbientDim>
 std::optional<Affine_space<ScalarT, AmbientDim>>
-space_with_space_intersection(
-  const Affine_space<ScalarT, AmbientDim>& /* unused */,
-  const Affine_space<ScalarT, AmbientDim>& /* unused */,
-  F /* unused */)
+space_with_space_intersection(Lhs&& lhs,
+                              const Affine_space<ScalarT, AmbientDim>& rhs,
+                              F compare)
 {
-  throw std::logic_error("Not implemented");
+  if (rhs.dimension() + 1 != AmbientDim)
+    throw std::logic_error("Not implemented");
+  const auto normal = orthonormal_complement(rhs.base(), compare).at(0);
+  const auto offset = normal * rhs.point();
+  return space_with_hyperplane_intersection(
+    std::forward<Lhs>(lhs), normal, offset, std::move(compare));
 }
 
-template<class ScalarT, unsigned AmbientDim, class F>
+template<class Lhs, class ScalarT, unsigned AmbientDim, class F>
+  requires Operand<Lhs, ScalarT, AmbientDim>
 std::optional<Affine_space<ScalarT, AmbientDim>>
-space_with_full_space_intersection(const Affine_space<ScalarT, AmbientDim>& lhs,
+space_with_full_space_intersection(Lhs&& lhs,
                                    const Affine_space<ScalarT, AmbientDim>& rhs,
                                    F /* unused */)
 {
   assert(rhs.dimension() == rhs.ambient_dimension());
-  return lhs;
+  return std::forward<Lhs>(lhs);
 }
 
-template<class ScalarT, class F>
+template<class Lhs, class ScalarT, class F>
+  requires Operand<Lhs, ScalarT, 1>
 std::optional<Affine_space<ScalarT, 1>>
-point_with_point_intersection(const Affine_space<ScalarT, 1>& lhs,
+point_with_point_intersection(Lhs&& lhs,
                               const Affine_space<ScalarT, 1>& rhs,
                               F compare)
 {
   assert(lhs.dimension() == 0 && rhs.dimension() == 0);
   if (compare(lhs.point()[0], rhs.point()[0]))
-    return lhs;
+    return std::forward<Lhs>(lhs);
   else
     return std::nullopt;
 }
 
-template<class ScalarT, unsigned AmbientDim, class F>
+template<class Lhs, class ScalarT, unsigned AmbientDim, class F>
+  requires Operand<Lhs, ScalarT, AmbientDim>
 std::optional<Affine_space<ScalarT, AmbientDim>>
-point_with_point_intersection(const Affine_space<ScalarT, AmbientDim>& lhs,
+point_with_point_intersection(Lhs&& lhs,
                               const Affine_space<ScalarT, AmbientDim>& rhs,
                               F compare)
 {
   assert(lhs.dimension() == 0 && rhs.dimension() == 0);
   if (compare(capd::vectalg::euclNorm(lhs.point() - rhs.point()), 0))
-    return lhs;
+    return std::forward<Lhs>(lhs);
   else
     return std::nullopt;
 }
 
-template<class ScalarT, unsigned AmbientDim, class F>
+template<class Lhs, class ScalarT, unsigned AmbientDim, class F>
+  requires Operand<Lhs, ScalarT, AmbientDim>
 std::optional<Affine_space<ScalarT, AmbientDim>>
-point_with_space_intersection(const Affine_space<ScalarT, AmbientDim>& lhs,
+point_with_space_intersection(Lhs&& lhs,
                               const Affine_space<ScalarT, AmbientDim>& rhs,
                               F compare)
 {
   assert(lhs.dimension() == 0);
   if (rhs.element(lhs.point(), std::move(compare)))
-    return lhs;
+    return std::forward<Lhs>(lhs);
   else
     return std::nullopt;
 }
 
-template<class ScalarT, class F>
+template<class Lhs, class ScalarT, class F>
+  requires Operand<Lhs, ScalarT, 2>
 std::optional<Affine_space<ScalarT, 2>>
-line_with_line_intersection(const Affine_space<ScalarT, 2>& lhs,
+line_with_line_intersection(Lhs&& lhs,
                             const Affine_space<ScalarT, 2>& rhs,
                             F compare)
 {
@@ -88,7 +139,7 @@ line_with_line_intersection(const Affine_space<ScalarT, 2>& lhs,
   const auto diff = b - a;
   if (compare(det, 0)) {
     if (compare(capd::vectalg::euclNorm(diff), 0))
-      return lhs;
+      return std::forward<Lhs>(lhs);
     else
       return std::nullopt;
   } else {
@@ -97,9 +148,10 @@ line_with_line_intersection(const Affine_space<ScalarT, 2>& lhs,
   }
 }
 
-template<class ScalarT, unsigned AmbientDim, class F>
+template<class Lhs, class ScalarT, unsigned AmbientDim, class F>
+  requires Operand<Lhs, ScalarT, AmbientDim>
 std::optional<Affine_space<ScalarT, AmbientDim>>
-line_with_line_intersection(const Affine_space<ScalarT, AmbientDim>& lhs,
+line_with_line_intersection(Lhs&& lhs,
                             const Affine_space<ScalarT, AmbientDim>& rhs,
                             F compare)
 {
@@ -111,7 +163,7 @@ line_with_line_intersection(const Affine_space<ScalarT, AmbientDim>& lhs,
   const auto norm = capd::vectalg::euclNorm(v);
   if (compare(norm, 0)) {
     if (rhs.element(lhs.point(), std::move(compare)))
-      return lhs;
+      return std::forward<Lhs>(lhs);
     else
       return std::nullopt;
   } else {
@@ -127,19 +179,22 @@ line_with_line_intersection(const Affine_space<ScalarT, AmbientDim>& lhs,
   }
 }
 
-template<class ScalarT, class F>
+template<class Lhs, class ScalarT, class F>
+  requires Operand<Lhs, ScalarT, 2>
 std::optional<Affine_space<ScalarT, 2>>
-line_with_codim_1_space_intersection(const Affine_space<ScalarT, 2>& lhs,
+line_with_codim_1_space_intersection(Lhs&& lhs,
                                      const Affine_space<ScalarT, 2>& rhs,
                                      F compare)
 {
-  return line_with_line_intersection(lhs, rhs, std::move(compare));
+  return line_with_line_intersection(
+    std::forward<Lhs>(lhs), rhs, std::move(compare));
 }
 
-template<class ScalarT, unsigned AmbientDim, class F>
+template<class Lhs, class ScalarT, unsigned AmbientDim, class F>
+  requires Operand<Lhs, ScalarT, AmbientDim>
 std::optional<Affine_space<ScalarT, AmbientDim>>
 line_with_codim_1_space_intersection(
-  const Affine_space<ScalarT, AmbientDim>& lhs,
+  Lhs&& lhs,
   const Affine_space<ScalarT, AmbientDim>& rhs,
   F compare)
 {
@@ -151,7 +206,7 @@ line_with_codim_1_space_intersection(
   }
   if (compare(capd::vectalg::euclNorm(v), 0)) {
     if (rhs.element(lhs.point(), std::move(compare)))
-      return lhs;
+      return std::forward<Lhs>(lhs);
     else
       return std::nullopt;
   } else {
@@ -162,9 +217,10 @@ line_with_codim_1_space_intersection(
   }
 }
 
-template<class ScalarT, class F>
+template<class Lhs, class ScalarT, class F>
+  requires Operand<Lhs, ScalarT, 3>
 std::optional<Affine_space<ScalarT, 3>>
-plane_with_plane_intersection(const Affine_space<ScalarT, 3>& lhs,
+plane_with_plane_intersection(Lhs&& lhs,
                               const Affine_space<ScalarT, 3>& rhs,
                               F compare)
 {
@@ -176,7 +232,7 @@ plane_with_plane_intersection(const Affine_space<ScalarT, 3>& lhs,
   const auto prod = n_1 * n_2;
   if (compare(prod * prod, 1)) {
     if (rhs.element(lhs.point(), std::move(compare)))
-      return lhs;
+      return std::forward<Lhs>(lhs);
     else
       return std::nullopt;
   } else {
@@ -189,13 +245,15 @@ plane_with_plane_intersection(const Affine_space<ScalarT, 3>& lhs,
   }
 }
 
-template<class ScalarT, unsigned AmbientDim, class F>
+template<class Lhs, class ScalarT, unsigned AmbientDim, class F>
+  requires Operand<Lhs, ScalarT, AmbientDim>
 std::optional<Affine_space<ScalarT, AmbientDim>>
-plane_with_plane_intersection(const Affine_space<ScalarT, AmbientDim>& lhs,
+plane_with_plane_intersection(Lhs&& lhs,
                               const Affine_space<ScalarT, AmbientDim>& rhs,
                               F compare)
 {
-  return space_with_space_intersection(lhs, rhs, std::move(compare));
+  return space_with_space_intersection(
+    std::forward<Lhs>(lhs), rhs, std::move(compare));
 }
 
 } // namespace detail
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "affine/affine_space.h"
+#include "affine/detail/affine_detail.h"
+#include "affine/detail/capd.h"
+
+namespace affine {
+
+namespace detail {
+
+// Kernels shared by Prepared_affine_space and Flat_collection. A prepared
+// flat stores the rows of whichever of its base and its orthogonal
+// complement is shorter, as a row-major array of AmbientDim scalars per row.
+
+constexpr bool
+prefers_complement(std::size_t dimension, std::size_t ambient_dim)
+{
+  return 2 * dimension > ambient_dim;
+}
+
+template<class ScalarT, unsigned AmbientDim, class F>
+std::vector<Point<ScalarT, AmbientDim>>
+prepared_rows(const Affine_space<ScalarT, AmbientDim>& affine_space, F compare)
+{
+  if (prefers_complement(affine_space.dimension(), AmbientDim))
+    return orthonormal_complement(affine_space.base(), std::move(compare));
+  return affine_space.base();
+}
+
+template<class ScalarT, class PointT>
+ScalarT
+row_product(const ScalarT* row, const PointT& v)
+{
+  ScalarT result{ 0 };
+  for (std::size_t k = 0; k < static_cast<std::size_t>(v.dimension()); ++k)
+    result += row[k] * v[k];
+  return result;
+}
+
+// Distance from the flat of the point whose difference from the particular
+// point is 'diff', given the products 'coefficients' of 'diff' with the
+// 'count' rows of the flat. With the complement these are the components of
+// the residual; with the base the residual is what remains of 'diff' after
+// removing them.
+template<class ScalarT, class PointT>
+ScalarT
+prepared_distance(bool complement,
+                  const ScalarT* rows,
+                  std::size_t count,
+                  const PointT& coefficients,
+                  const PointT& diff)
+{
+  if (complement)
+    return capd::vectalg::euclNorm(coefficients);
+  auto residual = diff;
+  const auto dim = static_cast<std::size_t>(diff.dimension());
+  for (std::size_t r = 0; r < count; ++r)
+    for (std::size_t k = 0; k < dim; ++k)
+      residual[k] -= coefficients[r] * rows[r * dim + k];
+  return capd::vectalg::euclNorm(residual);
+}
+
+// product[r * width + p] = sum_k rows[r * dim + k] * block[k * width + p],
+// i.e. the 'count' x 'width' product of stacked rows with a block of points
+// stored column by column. The innermost loop runs over the points, so it
+// vectorizes and every row is read once per block.
+template<class ScalarT>
+void
+block_product(const ScalarT* rows,
+              std::size_t count,
+              std::size_t dim,
+              const ScalarT* block,
+              std::size_t width,
+              ScalarT* product)
+{
+  for (std::size_t r = 0; r < count; ++r) {
+    auto* out = product + r * width;
+    for (std::size_t p = 0; p < width; ++p)
+      out[p] = 0;
+    for (std::size_t k = 0; k < dim; ++k) {
+      const auto factor = rows[r * dim + k];
+      const auto* in = block + k * width;
+      for (std::size_t p = 0; p < width; ++p)
+        out[p] += factor * in[p];
+    }
+  }
+}
+
+} // namespace detail
+
+} // namespace affine
@@ -0,0 +1,171 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <optional>
+#include <ranges>
+#include <vector>
+
+#include "affine/affine_fwd.h"
+#include "affine/affine_space.h"
+#include "affine/comparisons.h"
+#include "affine/detail/capd.h"
+#include "affine/intersection.h"
+#include "affine/detail/affine_detail.h"
+
+namespace affine {
+
+namespace detail {
+
+// Decides comparisons whose operands differ by more than the error bound
+// and flags every other comparison as ambiguous.
+class Filter_compare
+{
+public:
+  Filter_compare(double bound, bool& ambiguous)
+    : bound_{ bound }
+    , ambiguous_{ &ambiguous }
+  {
+  }
+
+  bool operator()(double lhs, double rhs) const
+  {
+    const auto scale = std::max({ 1.0, std::abs(lhs), std::abs(rhs) });
+    if (std::abs(lhs - rhs) > bound_ * scale)
+      return false;
+    *ambiguous_ = true;
+    return true;
+  }
+
+private:
+  double bound_;
+  bool* ambiguous_;
+};
+
+} // namespace detail
+
+// Affine_space<double, AmbientDim> paired with its interval enclosure.
+// Predicates are evaluated in double first and recomputed with intervals and
+// IApprox_equal only when the double result is within the error bound.
+template<unsigned AmbientDim>
+class Filtered_affine_space
+{
+public:
+  using Point = detail::Point<double, AmbientDim>;
+  using IPoint = detail::Point<capd::DInterval, AmbientDim>;
+  using Approximate = Affine_space<double, AmbientDim>;
+  using Exact = Affine_space<capd::DInterval, AmbientDim>;
+
+  explicit Filtered_affine_space(const Point& particular_point,
+                                 const std::vector<Point>& generators = {})
+    : Filtered_affine_space(
+        Exact(detail::rebind<capd::DInterval>(particular_point),
+              generators | std::views::transform([](const Point& v) {
+                return detail::rebind<capd::DInterval>(v);
+              }),
+              IApprox_equal()))
+  {
+  }
+
+  explicit Filtered_affine_space(Exact exact)
+    : exact_(std::move(exact))
+  {
+    auto accumulate = [this](const IPoint& v) {
+      for (std::size_t i = 0; i < AmbientDim; ++i) {
+        magnitude_ = std::max(magnitude_, std::abs(v[i].leftBound()));
+        magnitude_ = std::max(magnitude_, std::abs(v[i].rightBound()));
+        width_ = std::max(width_, v[i].rightBound() - v[i].leftBound());
+      }
+    };
+    accumulate(exact_.point());
+    std::vector<Point> base;
+    for (auto&& v : exact_.base()) {
+      accumulate(v);
+      base.push_back(midpoint(v));
+    }
+    approximate_ =
+      Approximate(orthonormal, midpoint(exact_.point()), std::move(base));
+  }
+
+  template<std::ranges::input_range R>
+    requires std::convertible_to<std::ranges::range_value_t<R>, Point> &&
+             std::ranges::sized_range<R>
+  static Filtered_affine_space spanning_space(R&& points)
+  {
+    std::vector<IPoint> ipoints;
+    for (auto&& p : points)
+      ipoints.push_back(detail::rebind<capd::DInterval>(p));
+    return Filtered_affine_space(
+      Exact::spanning_space(std::move(ipoints), IApprox_equal()));
+  }
+
+  static Filtered_affine_space spanning_space(std::initializer_list<Point> il)
+  {
+    return spanning_space(std::vector<Point>(il));
+  }
+
+  std::size_t dimension() const { return approximate_.dimension(); }
+
+  const Approximate& approximate() const { return approximate_; }
+
+  const Exact& exact() const { return exact_; }
+
+  // Error bound of double evaluations on data of the given magnitude.
+  double error_bound(double magnitude) const
+  {
+    constexpr auto eps = std::numeric_limits<double>::epsilon();
+    const auto terms = 4.0 * (AmbientDim + 2) * (AmbientDim + 2);
+    return (terms * eps + 2 * width_) *
+           std::max({ 1.0, magnitude, magnitude_ });
+  }
+
+  bool element(const Point& point) const
+  {
+    bool ambiguous = false;
+    const auto magnitude = std::ranges::max(
+      point | std::views::transform([](double x) { return std::abs(x); }));
+    const auto result = approximate_.element(
+      point, detail::Filter_compare(error_bound(magnitude), ambiguous));
+    if (!ambiguous)
+      return result;
+    return exact_.element(detail::rebind<capd::DInterval>(point),
+                          IApprox_equal());
+  }
+
+private:
+  static Point midpoint(const IPoint& v)
+  {
+    Point result;
+    for (std::size_t i = 0; i < AmbientDim; ++i)
+      result[i] = detail::representative(v[i]);
+    return result;
+  }
+
+  Exact exact_;
+  Approximate approximate_{};
+  double magnitude_ = 0.0;
+  double width_ = 0.0;
+};
+
+// Whether the intersection is empty and its dimension are decided rigorously;
+// the coordinates of the result are double approximations.
+template<unsigned AmbientDim>
+std::optional<Affine_space<double, AmbientDim>>
+intersection(const Filtered_affine_space<AmbientDim>& lhs,
+             const Filtered_affine_space<AmbientDim>& rhs)
+{
+  bool ambiguous = false;
+  const auto bound = std::max(lhs.error_bound(0.0), rhs.error_bound(0.0));
+  auto result = intersection(lhs.approximate(),
+                             rhs.approximate(),
+                             detail::Filter_compare(bound, ambiguous));
+  if (!ambiguous)
+    return result;
+  const auto exact = intersection(lhs.exact(), rhs.exact(), IApprox_equal());
+  if (!exact)
+    return std::nullopt;
+  return Filtered_affine_space<AmbientDim>(*exact).approximate();
+}
+
+} // namespace affine
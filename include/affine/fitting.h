@@ -0,0 +1,270 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <ranges>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "affine/affine_fwd.h"
+#include "affine/accumulation.h"
+#include "affine/affine_space.h"
+#include "affine/detail/capd.h"
+#include "affine/prepared_affine_space.h"
+#include "affine/detail/affine_detail.h"
+
+namespace affine {
+
+namespace detail {
+
+// Cyclic Jacobi eigenvalue algorithm for a symmetric row-major matrix.
+// Returns the eigenvectors ordered by decreasing eigenvalue.
+template<class T, std::size_t N>
+std::array<std::array<T, N>, N>
+symmetric_eigenvectors(std::array<T, N * N> a)
+{
+  std::array<T, N * N> v{};
+  for (std::size_t i = 0; i < N; ++i)
+    v[i * N + i] = 1;
+  for (int sweep = 0; sweep < 64; ++sweep) {
+    T off_diagonal{ 0 };
+    T diagonal{ 0 };
+    for (std::size_t p = 0; p < N; ++p) {
+      diagonal += a[p * N + p] * a[p * N + p];
+      for (std::size_t q = p + 1; q < N; ++q)
+        off_diagonal += a[p * N + q] * a[p * N + q];
+    }
+    if (off_diagonal <= std::numeric_limits<T>::epsilon() *
+                          std::numeric_limits<T>::epsilon() * diagonal)
+      break;
+    for (std::size_t p = 0; p < N; ++p) {
+      for (std::size_t q = p + 1; q < N; ++q) {
+        if (a[p * N + q] == 0)
+          continue;
+        const T theta = (a[q * N + q] - a[p * N + p]) / (2 * a[p * N + q]);
+        const T t = (theta >= 0 ? 1 : -1) /
+                    (std::abs(theta) + std::sqrt(theta * theta + 1));
+        const T c = 1 / std::sqrt(t * t + 1);
+        const T s = t * c;
+        for (std::size_t k = 0; k < N; ++k) {
+          const T a_kp = a[k * N + p];
+          const T a_kq = a[k * N + q];
+          a[k * N + p] = c * a_kp - s * a_kq;
+          a[k * N + q] = s * a_kp + c * a_kq;
+        }
+        for (std::size_t k = 0; k < N; ++k) {
+          const T a_pk = a[p * N + k];
+          const T a_qk = a[q * N + k];
+          a[p * N + k] = c * a_pk - s * a_qk;
+          a[q * N + k] = s * a_pk + c * a_qk;
+        }
+        for (std::size_t k = 0; k < N; ++k) {
+          const T v_kp = v[k * N + p];
+          const T v_kq = v[k * N + q];
+          v[k * N + p] = c * v_kp - s * v_kq;
+          v[k * N + q] = s * v_kp + c * v_kq;
+        }
+      }
+    }
+  }
+  std::array<std::size_t, N> order{};
+  for (std::size_t i = 0; i < N; ++i)
+    order[i] = i;
+  std::ranges::sort(order, std::ranges::greater{}, [&a](std::size_t i) {
+    return a[i * N + i];
+  });
+  std::array<std::array<T, N>, N> result{};
+  for (std::size_t i = 0; i < N; ++i)
+    for (std::size_t k = 0; k < N; ++k)
+      result[i][k] = v[k * N + order[i]];
+  return result;
+}
+
+} // namespace detail
+
+// Best-fit flat of a given dimension in the least squares sense. Points are
+// accumulated in a single pass (Welford update of centroid and scatter
+// matrix), so the data can be streamed in chunks.
+template<class ScalarT, unsigned AmbientDim>
+  requires std::floating_point<ScalarT>
+class Flat_fitter
+{
+public:
+  using Scalar = ScalarT;
+  using Point = detail::Point<ScalarT, AmbientDim>;
+
+  void add(const Point& point)
+  {
+    ++count_;
+    std::array<Acc, AmbientDim> delta{};
+    for (std::size_t i = 0; i < AmbientDim; ++i) {
+      delta[i] = static_cast<Acc>(point[i]) - mean_[i];
+      mean_[i] += delta[i] / static_cast<Acc>(count_);
+    }
+    for (std::size_t i = 0; i < AmbientDim; ++i)
+      for (std::size_t j = 0; j < AmbientDim; ++j)
+        scatter_[i * AmbientDim + j] +=
+          delta[i] * (static_cast<Acc>(point[j]) - mean_[j]);
+  }
+
+  template<std::ranges::input_range R>
+    requires std::convertible_to<std::ranges::range_value_t<R>, Point>
+  void add(R&& points)
+  {
+    for (auto&& point : points)
+      add(point);
+  }
+
+  std::size_t count() const { return count_; }
+
+  Point centroid() const
+  {
+    Point result;
+    for (std::size_t i = 0; i < AmbientDim; ++i)
+      result[i] = static_cast<ScalarT>(mean_[i]);
+    return result;
+  }
+
+  template<class F>
+  Affine_space<ScalarT, AmbientDim> fit(std::size_t dimension, F compare) const
+  {
+    if (count_ == 0)
+      throw std::invalid_argument("no points were added");
+    if (dimension > AmbientDim)
+      throw std::invalid_argument(
+        "'dimension' cannot exceed the ambient dimension");
+    const auto eigenvectors =
+      detail::symmetric_eigenvectors<Acc, AmbientDim>(scatter_);
+    std::vector<Point> generators(dimension);
+    for (std::size_t i = 0; i < dimension; ++i)
+      for (std::size_t j = 0; j < AmbientDim; ++j)
+        generators[i][j] = static_cast<ScalarT>(eigenvectors[i][j]);
+    return Affine_space<ScalarT, AmbientDim>(
+      centroid(), std::move(generators), std::move(compare));
+  }
+
+private:
+  using Acc = accumulation_t<ScalarT>;
+
+  std::size_t count_ = 0;
+  std::array<Acc, AmbientDim> mean_{};
+  std::array<Acc, AmbientDim * AmbientDim> scatter_{};
+};
+
+struct Ransac_parameters
+{
+  std::size_t iterations = 256;
+  std::uint64_t seed = 0;
+  unsigned threads = 0;
+};
+
+// Robust fit of a flat of the given dimension. Hypotheses spanned by random
+// samples are scored in parallel by the number of points 'compare' accepts
+// as their elements, and the best one is refitted on its inliers. Returns
+// std::nullopt if every sampled hypothesis was degenerate. An exception
+// thrown while scoring is rethrown on the calling thread.
+template<std::ranges::random_access_range R,
+         class F,
+         class Traits = detail::Is_point<std::ranges::range_value_t<R>>>
+  requires Traits::value && std::ranges::sized_range<R>
+std::optional<Affine_space<typename Traits::scalar, Traits::ambient_dim>>
+ransac(const R& points,
+       std::size_t dimension,
+       F compare,
+       Ransac_parameters parameters = {})
+{
+  namespace rs = std::ranges;
+  using ScalarT = typename Traits::scalar;
+  constexpr auto AmbientDim = Traits::ambient_dim;
+  using Aff_space = Affine_space<ScalarT, AmbientDim>;
+  using Point = detail::Point<ScalarT, AmbientDim>;
+  const auto size = rs::size(points);
+  if (dimension > AmbientDim)
+    throw std::invalid_argument(
+      "'dimension' cannot exceed the ambient dimension");
+  if (size < dimension + 1)
+    throw std::invalid_argument("not enough points to span a hypothesis");
+
+  std::vector<std::size_t> samples(parameters.iterations * (dimension + 1));
+  std::mt19937_64 engine(parameters.seed);
+  std::uniform_int_distribution<std::size_t> distribution(0, size - 1);
+  for (std::size_t h = 0; h < parameters.iterations; ++h) {
+    const auto sample = samples.begin() + h * (dimension + 1);
+    for (std::size_t i = 0; i <= dimension; ++i) {
+      do
+        sample[i] = distribution(engine);
+      while (std::find(sample, sample + i, sample[i]) != sample + i);
+    }
+  }
+
+  std::vector<std::size_t> scores(parameters.iterations, 0);
+  std::atomic<std::size_t> next_hypothesis = 0;
+  std::mutex error_mutex;
+  std::exception_ptr error;
+  auto worker = [&] {
+    try {
+      std::vector<Point> sample_points(dimension + 1);
+      for (auto h = next_hypothesis++; h < parameters.iterations;
+           h = next_hypothesis++) {
+        for (std::size_t i = 0; i <= dimension; ++i)
+          sample_points[i] =
+            rs::begin(points)[samples[h * (dimension + 1) + i]];
+        const auto hypothesis =
+          Aff_space::spanning_space(sample_points, compare);
+        if (hypothesis.dimension() != dimension)
+          continue;
+        const Prepared_affine_space prepared(hypothesis, compare);
+        scores[h] = static_cast<std::size_t>(
+          rs::count_if(points, [&](const Point& p) {
+            return prepared.element(p, compare);
+          }));
+      }
+    } catch (...) {
+      next_hypothesis = parameters.iterations;
+      std::lock_guard lock(error_mutex);
+      if (!error)
+        error = std::current_exception();
+    }
+  };
+  const auto threads = std::min<std::size_t>(
+    parameters.threads != 0
+      ? parameters.threads
+      : std::max(1u, std::thread::hardware_concurrency()),
+    parameters.iterations);
+  {
+    std::vector<std::jthread> pool;
+    for (std::size_t i = 1; i < threads; ++i)
+      pool.emplace_back(worker);
+    worker();
+  }
+  if (error)
+    std::rethrow_exception(error);
+
+  const auto best = rs::max_element(scores);
+  if (best == scores.end() || *best == 0)
+    return std::nullopt;
+  const auto h = static_cast<std::size_t>(rs::distance(scores.begin(), best));
+  std::vector<Point> sample_points(dimension + 1);
+  for (std::size_t i = 0; i <= dimension; ++i)
+    sample_points[i] = rs::begin(points)[samples[h * (dimension + 1) + i]];
+  const Prepared_affine_space prepared(
+    Aff_space::spanning_space(sample_points, compare), compare);
+  Flat_fitter<ScalarT, AmbientDim> fitter;
+  for (auto&& p : points)
+    if (prepared.element(p, compare))
+      fitter.add(p);
+  return fitter.fit(dimension, std::move(compare));
+}
+
+} // namespace affine
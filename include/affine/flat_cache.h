@@ -0,0 +1,178 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "affine/affine_fwd.h"
+#include "affine/affine_space.h"
+#include "affine/canonical.h"
+#include "affine/intersection.h"
+
+namespace affine {
+
+// Thread-safe deduplication table of flats and memoization of their pairwise
+// intersections. Flats are keyed by their quantized canonical form and
+// matched with 'compare', so equal flats built from different points share
+// an entry. Each shard is guarded by its own mutex. A flat is stored under
+// its hash_value and looked up under all of its hash_values, so that
+// equivalent flats are merged even when their canonical coordinates round to
+// different cells; 'resolution' should be at least 8 times the distance
+// 'compare' accepts as zero.
+template<class ScalarT, unsigned AmbientDim, class F>
+class Flat_cache
+{
+public:
+  using Aff_space = Affine_space<ScalarT, AmbientDim>;
+
+  explicit Flat_cache(F compare,
+                      double resolution = 1e-9,
+                      std::size_t shards = 64)
+    : compare_(std::move(compare))
+    , resolution_(resolution)
+    , shards_count_(shards)
+    , shards_(std::make_unique<Shard[]>(shards))
+  {
+    if (resolution_ <= 0.0)
+      throw std::domain_error("resolution must be positive real number");
+    if (shards_count_ == 0)
+      throw std::invalid_argument("'shards' cannot be zero");
+  }
+
+  // Returns the stored canonical representative of 'affine_space', inserting
+  // it on first use.
+  Aff_space intern(const Aff_space& affine_space)
+  {
+    const auto keys = hash_values(affine_space, resolution_, compare_);
+    {
+      const auto locks = lock_shards(keys);
+      if (auto found = find_flat(keys, affine_space))
+        return *found;
+    }
+    auto canonical_space = canonical(affine_space, compare_);
+    const auto locks = lock_shards(keys);
+    if (auto found = find_flat(keys, affine_space))
+      return *found;
+    shard_for(keys.front()).flats.emplace(keys.front(), canonical_space);
+    return canonical_space;
+  }
+
+  std::optional<Aff_space> intersection(const Aff_space& lhs,
+                                        const Aff_space& rhs)
+  {
+    const auto lhs_keys = hash_values(lhs, resolution_, compare_);
+    const auto rhs_keys = hash_values(rhs, resolution_, compare_);
+    std::vector<std::size_t> keys;
+    for (auto lhs_key : lhs_keys)
+      for (auto rhs_key : rhs_keys)
+        keys.push_back(pair_key(lhs_key, rhs_key));
+    {
+      const auto locks = lock_shards(keys);
+      if (auto found = find_pair(keys, lhs, rhs))
+        return *found;
+    }
+    auto result = affine::intersection(lhs, rhs, compare_);
+    const auto locks = lock_shards(keys);
+    if (auto found = find_pair(keys, lhs, rhs))
+      return *found;
+    shard_for(keys.front())
+      .pairs.emplace(keys.front(), Pair_entry{ lhs, rhs, result });
+    return result;
+  }
+
+  std::size_t size() const
+  {
+    std::size_t result = 0;
+    for (std::size_t i = 0; i < shards_count_; ++i) {
+      std::scoped_lock lock(shards_[i].mutex);
+      result += shards_[i].flats.size() + shards_[i].pairs.size();
+    }
+    return result;
+  }
+
+private:
+  struct Pair_entry
+  {
+    Aff_space lhs;
+    Aff_space rhs;
+    std::optional<Aff_space> result;
+  };
+
+  struct Shard
+  {
+    mutable std::mutex mutex;
+    std::unordered_multimap<std::size_t, Aff_space> flats;
+    std::unordered_multimap<std::size_t, Pair_entry> pairs;
+  };
+
+  Shard& shard_for(std::size_t key) { return shards_[key % shards_count_]; }
+
+  static std::size_t pair_key(std::size_t lhs_key, std::size_t rhs_key)
+  {
+    if (rhs_key < lhs_key)
+      std::swap(lhs_key, rhs_key);
+    detail::hash_combine(lhs_key, rhs_key);
+    return lhs_key;
+  }
+
+  // Locks the shards of all 'keys' in increasing order of their index, so
+  // that concurrent calls cannot deadlock.
+  std::vector<std::unique_lock<std::mutex>> lock_shards(
+    const std::vector<std::size_t>& keys)
+  {
+    std::vector<std::size_t> indices;
+    for (auto key : keys)
+      indices.push_back(key % shards_count_);
+    std::ranges::sort(indices);
+    const auto [first, last] = std::ranges::unique(indices);
+    indices.erase(first, last);
+    std::vector<std::unique_lock<std::mutex>> locks;
+    for (auto i : indices)
+      locks.emplace_back(shards_[i].mutex);
+    return locks;
+  }
+
+  const Aff_space* find_flat(const std::vector<std::size_t>& keys,
+                             const Aff_space& affine_space)
+  {
+    for (auto key : keys) {
+      const auto [first, last] = shard_for(key).flats.equal_range(key);
+      for (auto iter = first; iter != last; ++iter)
+        if (equivalent(iter->second, affine_space, compare_))
+          return &iter->second;
+    }
+    return nullptr;
+  }
+
+  const std::optional<Aff_space>* find_pair(
+    const std::vector<std::size_t>& keys,
+    const Aff_space& lhs,
+    const Aff_space& rhs)
+  {
+    for (auto key : keys) {
+      const auto [first, last] = shard_for(key).pairs.equal_range(key);
+      for (auto iter = first; iter != last; ++iter) {
+        const auto& entry = iter->second;
+        if ((equivalent(entry.lhs, lhs, compare_) &&
+             equivalent(entry.rhs, rhs, compare_)) ||
+            (equivalent(entry.lhs, rhs, compare_) &&
+             equivalent(entry.rhs, lhs, compare_)))
+          return &entry.result;
+      }
+    }
+    return nullptr;
+  }
+
+  F compare_;
+  double resolution_;
+  std::size_t shards_count_;
+  std::unique_ptr<Shard[]> shards_;
+};
+
+} // namespace affine
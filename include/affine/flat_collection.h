@@ -0,0 +1,173 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <ranges>
+#include <vector>
+
+#include "affine/affine_fwd.h"
+#include "affine/affine_space.h"
+#include "affine/detail/affine_detail.h"
+#include "affine/detail/capd.h"
+#include "affine/detail/prepared_detail.h"
+
+namespace affine {
+
+// Flats of a common ambient dimension packed into two contiguous row-major
+// matrices: the particular points and the stacked rows of every flat. Like
+// Prepared_affine_space, each flat keeps the shorter of its base and its
+// orthogonal complement. The products of the rows with the particular point
+// of their flat are kept as well, so that testing a block of points takes
+// one product of the stacked rows with the block.
+template<class ScalarT, unsigned AmbientDim>
+class Flat_collection
+{
+public:
+  using Scalar = ScalarT;
+  using Point = detail::Point<ScalarT, AmbientDim>;
+  using Aff_space = Affine_space<ScalarT, AmbientDim>;
+
+  // Points per block and stacked rows per tile of the block product.
+  static constexpr std::size_t block_size = 64;
+  static constexpr std::size_t tile_rows = 64;
+
+  template<class F>
+  void push_back(const Aff_space& affine_space, F compare)
+  {
+    const auto rows = detail::prepared_rows(affine_space, std::move(compare));
+    const auto& point = affine_space.point();
+    for (std::size_t k = 0; k < AmbientDim; ++k)
+      points_.push_back(point[k]);
+    for (auto&& v : rows) {
+      for (std::size_t k = 0; k < AmbientDim; ++k)
+        rows_.push_back(v[k]);
+      point_products_.push_back(v * point);
+    }
+    offsets_.push_back(offsets_.back() + rows.size());
+    complement_.push_back(
+      detail::prefers_complement(affine_space.dimension(), AmbientDim));
+    dimensions_.push_back(affine_space.dimension());
+  }
+
+  std::size_t size() const { return dimensions_.size(); }
+
+  constexpr std::size_t ambient_dimension() const { return AmbientDim; }
+
+  std::size_t dimension(std::size_t i) const { return dimensions_.at(i); }
+
+  Scalar distance(std::size_t i, const Point& point) const
+  {
+    const auto diff = point - particular_point(i);
+    Point coefficients{};
+    for (std::size_t r = 0; r < rows(i); ++r)
+      coefficients[r] = detail::row_product(row(offsets_[i] + r), diff);
+    return detail::prepared_distance(
+      complement_[i] != 0, row(offsets_[i]), rows(i), coefficients, diff);
+  }
+
+  // Membership of 'point' in every flat of the collection, one byte per
+  // flat.
+  template<class F>
+  std::vector<std::uint8_t> element(const Point& point, F compare) const
+  {
+    std::vector<std::uint8_t> result(size());
+    for (std::size_t i = 0; i < size(); ++i)
+      result[i] = compare(distance(i, point), 0);
+    return result;
+  }
+
+  // Membership of every point in every flat, one byte per pair, point-major:
+  // the entry for point p and flat i is at p * size() + i. For each block of
+  // points the rows of a tile of flats are multiplied with the whole block at
+  // once, and the residual of every pair is reduced from that product.
+  template<std::ranges::random_access_range R, class F>
+    requires std::convertible_to<std::ranges::range_value_t<R>, Point> &&
+             std::ranges::sized_range<R>
+  std::vector<std::uint8_t> element(R&& points, F compare) const
+  {
+    namespace rs = std::ranges;
+    const auto count = static_cast<std::size_t>(rs::size(points));
+    std::vector<std::uint8_t> result(count * size());
+    std::vector<ScalarT> block(AmbientDim * block_size);
+    std::vector<ScalarT> product;
+    for (std::size_t first = 0; first < count; first += block_size) {
+      const auto width = std::min(count - first, block_size);
+      for (std::size_t p = 0; p < width; ++p) {
+        const Point x = rs::begin(points)[first + p];
+        for (std::size_t k = 0; k < AmbientDim; ++k)
+          block[k * width + p] = x[k];
+      }
+      for (std::size_t tile = 0; tile < size();) {
+        auto last = tile + 1;
+        while (last < size() &&
+               offsets_[last + 1] - offsets_[tile] <= tile_rows)
+          ++last;
+        const auto tile_count = offsets_[last] - offsets_[tile];
+        product.resize(tile_count * width);
+        detail::block_product(row(offsets_[tile]),
+                              tile_count,
+                              AmbientDim,
+                              block.data(),
+                              width,
+                              product.data());
+        for (auto i = tile; i < last; ++i)
+          for (std::size_t p = 0; p < width; ++p)
+            result[(first + p) * size() + i] =
+              compare(residual(i, product, offsets_[tile], width, p, block), 0);
+        tile = last;
+      }
+    }
+    return result;
+  }
+
+private:
+  std::size_t rows(std::size_t i) const
+  {
+    return offsets_[i + 1] - offsets_[i];
+  }
+
+  const ScalarT* row(std::size_t r) const
+  {
+    return rows_.data() + r * AmbientDim;
+  }
+
+  Point particular_point(std::size_t i) const
+  {
+    Point result;
+    for (std::size_t k = 0; k < AmbientDim; ++k)
+      result[k] = points_[i * AmbientDim + k];
+    return result;
+  }
+
+  // Distance of the p-th point of 'block' from flat i, given the product of
+  // the block with the rows of a tile starting at row 'tile_offset'.
+  Scalar residual(std::size_t i,
+                  const std::vector<ScalarT>& product,
+                  std::size_t tile_offset,
+                  std::size_t width,
+                  std::size_t p,
+                  const std::vector<ScalarT>& block) const
+  {
+    Point coefficients{};
+    for (std::size_t r = 0; r < rows(i); ++r) {
+      const auto stacked = offsets_[i] + r;
+      coefficients[r] = product[(stacked - tile_offset) * width + p] -
+                        point_products_[stacked];
+    }
+    Point diff;
+    for (std::size_t k = 0; k < AmbientDim; ++k)
+      diff[k] = block[k * width + p] - points_[i * AmbientDim + k];
+    return detail::prepared_distance(
+      complement_[i] != 0, row(offsets_[i]), rows(i), coefficients, diff);
+  }
+
+  std::vector<ScalarT> points_{};
+  std::vector<ScalarT> rows_{};
+  std::vector<ScalarT> point_products_{};
+  std::vector<std::size_t> offsets_{ 0 };
+  std::vector<std::uint8_t> complement_{};
+  std::vector<std::size_t> dimensions_{};
+};
+
+} // namespace affine
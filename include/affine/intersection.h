@@ -3,63 +3,119 @@
 #include <algorithm>
 #include <functional>
 #include <optional>
+#include <type_traits>
+#include <utility>
 
+#include "affine/affine_fwd.h"
 #include "affine/affine_space.h"
 #include "affine/detail/intersection_detail.h"
 
 namespace affine {
 
-template<class ScalarT, unsigned AmbientDim, class F>
+namespace detail {
+
+// 'first' is the operand of lower dimension; it is the one the degenerate
+// cases return, so it is forwarded to the kernels.
+template<class Lhs, class ScalarT, unsigned AmbientDim, class F>
+  requires Operand<Lhs, ScalarT, AmbientDim>
 std::optional<Affine_space<ScalarT, AmbientDim>>
-intersection(const Affine_space<ScalarT, AmbientDim>& lhs,
-             const Affine_space<ScalarT, AmbientDim>& rhs,
-             F compare)
+ordered_intersection(Lhs&& first,
+                     const Affine_space<ScalarT, AmbientDim>& second,
+                     F compare)
 {
-  namespace rs = std::ranges;
-  using Aff_space = Affine_space<ScalarT, AmbientDim>;
-  const auto& [first, second] =
-    rs::minmax(lhs, rhs, {}, std::mem_fn(&Aff_space::dimension));
   if (second.dimension() == AmbientDim)
     return detail::space_with_full_space_intersection(
-      first, second, std::move(compare));
+      std::forward<Lhs>(first), second, std::move(compare));
   switch (first.dimension()) {
     case 0: {
       switch (second.dimension()) {
         case 0:
           return detail::point_with_point_intersection(
-            first, second, std::move(compare));
+            std::forward<Lhs>(first), second, std::move(compare));
         default:
           return detail::point_with_space_intersection(
-            first, second, std::move(compare));
+            std::forward<Lhs>(first), second, std::move(compare));
       }
     }
     case 1: {
       if (second.dimension() == AmbientDim - 1)
         return detail::line_with_codim_1_space_intersection(
-          first, second, std::move(compare));
+          std::forward<Lhs>(first), second, std::move(compare));
       switch (second.dimension()) {
         case 1:
           return detail::line_with_line_intersection(
-            first, second, std::move(compare));
+            std::forward<Lhs>(first), second, std::move(compare));
         default:
           return detail::space_with_space_intersection(
-            first, second, std::move(compare));
+            std::forward<Lhs>(first), second, std::move(compare));
       }
     }
     case 2: {
       switch (second.dimension()) {
         case 2:
           return detail::plane_with_plane_intersection(
-            first, second, std::move(compare));
+            std::forward<Lhs>(first), second, std::move(compare));
         default:
           return detail::space_with_space_intersection(
-            first, second, std::move(compare));
+            std::forward<Lhs>(first), second, std::move(compare));
       }
     }
     default:
       return detail::space_with_space_intersection(
-        first, second, std::move(compare));
+        std::forward<Lhs>(first), second, std::move(compare));
   }
 }
 
+template<class Lhs, class Rhs, class F>
+std::optional<std::remove_cvref_t<Lhs>>
+intersection_impl(Lhs&& lhs, Rhs&& rhs, F compare)
+{
+  if (rhs.dimension() < lhs.dimension())
+    return ordered_intersection(
+      std::forward<Rhs>(rhs), lhs, std::move(compare));
+  return ordered_intersection(std::forward<Lhs>(lhs), rhs, std::move(compare));
+}
+
+} // namespace detail
+
+template<class ScalarT, unsigned AmbientDim, class F>
+std::optional<Affine_space<ScalarT, AmbientDim>>
+intersection(const Affine_space<ScalarT, AmbientDim>& lhs,
+             const Affine_space<ScalarT, AmbientDim>& rhs,
+             F compare)
+{
+  return detail::intersection_impl(lhs, rhs, std::move(compare));
+}
+
+// The overloads below reuse the storage of an expiring operand for the
+// result, e.g. when folding a range with 'acc = intersection(std::move(acc),
+// ...)'.
+template<class ScalarT, unsigned AmbientDim, class F>
+std::optional<Affine_space<ScalarT, AmbientDim>>
+intersection(Affine_space<ScalarT, AmbientDim>&& lhs,
+             const Affine_space<ScalarT, AmbientDim>& rhs,
+             F compare)
+{
+  return detail::intersection_impl(std::move(lhs), rhs, std::move(compare));
+}
+
+template<class ScalarT, unsigned AmbientDim, class F>
+std::optional<Affine_space<ScalarT, AmbientDim>>
+intersection(const Affine_space<ScalarT, AmbientDim>& lhs,
+             Affine_space<ScalarT, AmbientDim>&& rhs,
+             F compare)
+{
+  return detail::intersection_impl(lhs, std::move(rhs), std::move(compare));
+}
+
+template<class ScalarT, unsigned AmbientDim, class F>
+std::optional<Affine_space<ScalarT, AmbientDim>>
+intersection(Affine_space<ScalarT, AmbientDim>&& lhs,
+             Affine_space<ScalarT, AmbientDim>&& rhs,
+             F compare)
+{
+  return detail::intersection_impl(
+    std::move(lhs), std::move(rhs), std::move(compare));
+}
+
 } // namespace affine
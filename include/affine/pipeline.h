@@ -0,0 +1,218 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <semaphore>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "affine/affine_fwd.h"
+#include "affine/affine_space.h"
+#include "affine/intersection.h"
+
+namespace affine {
+
+struct Pipeline_parameters
+{
+  unsigned threads = 0;
+  // Chunks submitted but not yet taken by 'next'; 0 means twice the number
+  // of threads.
+  std::size_t capacity = 0;
+};
+
+// Applies 'function' to every item of the submitted chunks on a pool of
+// worker threads. 'submit' blocks while 'capacity' chunks are in flight and
+// 'next' hands out the results chunk by chunk in submission order, so one
+// thread can feed the pipeline while another drains it. An exception thrown
+// while processing a chunk is rethrown by the 'next' call delivering it.
+// Results are written into a ring of capacity + 1 slots; the spare slot is
+// where 'close' signals the end of the input to a waiting 'next'.
+template<class Input, class Output>
+class Pipeline
+{
+public:
+  using Chunk = std::vector<Input>;
+  using Result = std::vector<Output>;
+
+  explicit Pipeline(std::function<Output(Input&&)> function,
+                    Pipeline_parameters parameters = {})
+    : function_(std::move(function))
+    , threads_(parameters.threads != 0
+                 ? parameters.threads
+                 : std::max(1u, std::thread::hardware_concurrency()))
+    , capacity_(parameters.capacity != 0 ? parameters.capacity
+                                         : 2 * std::size_t{ threads_ })
+    , slots_(std::make_unique<Slot[]>(capacity_ + 1))
+    , free_slots_(static_cast<std::ptrdiff_t>(capacity_))
+  {
+    for (unsigned i = 0; i < threads_; ++i)
+      workers_.emplace_back([this] { work(); });
+  }
+
+  Pipeline(const Pipeline&) = delete;
+  Pipeline& operator=(const Pipeline&) = delete;
+
+  ~Pipeline()
+  {
+    {
+      std::lock_guard lock(mutex_);
+      jobs_.clear();
+    }
+    pending_jobs_.release(threads_);
+  }
+
+  void submit(Chunk chunk)
+  {
+    // Checked before waiting as well, so that submitting to a closed and
+    // full pipeline throws instead of blocking forever.
+    {
+      std::lock_guard lock(mutex_);
+      if (closed_)
+        throw std::logic_error("cannot submit to a closed pipeline");
+    }
+    free_slots_.acquire();
+    {
+      std::lock_guard lock(mutex_);
+      if (closed_) {
+        free_slots_.release();
+        throw std::logic_error("cannot submit to a closed pipeline");
+      }
+      jobs_.push_back({ submitted_++, std::move(chunk) });
+    }
+    pending_jobs_.release();
+  }
+
+  // No further chunks will be submitted; 'next' returns std::nullopt once
+  // the results of all submitted chunks have been taken.
+  void close()
+  {
+    std::lock_guard lock(mutex_);
+    if (closed_)
+      return;
+    closed_ = true;
+    auto& state = slot(submitted_).state;
+    state.store(closed);
+    state.notify_all();
+  }
+
+  // To be called from one thread at a time.
+  std::optional<Result> next()
+  {
+    std::size_t sequence;
+    {
+      std::lock_guard lock(mutex_);
+      sequence = delivered_;
+    }
+    auto& current = slot(sequence);
+    current.state.wait(empty);
+    if (current.state.load() == closed)
+      return std::nullopt;
+    auto result = std::move(current.result);
+    auto error = std::exchange(current.error, nullptr);
+    current.state.store(empty);
+    {
+      std::lock_guard lock(mutex_);
+      ++delivered_;
+    }
+    free_slots_.release();
+    if (error)
+      std::rethrow_exception(error);
+    return result;
+  }
+
+private:
+  static constexpr int empty = 0;
+  static constexpr int ready = 1;
+  static constexpr int closed = 2;
+
+  struct Job
+  {
+    std::size_t sequence;
+    Chunk chunk;
+  };
+
+  struct Slot
+  {
+    std::atomic<int> state = empty;
+    Result result{};
+    std::exception_ptr error{};
+  };
+
+  Slot& slot(std::size_t sequence) const
+  {
+    return slots_[sequence % (capacity_ + 1)];
+  }
+
+  // Every release of 'pending_jobs_' but those of the destructor follows a
+  // push to 'jobs_', so a worker finds the queue empty only when stopping.
+  void work()
+  {
+    while (true) {
+      pending_jobs_.acquire();
+      Job job;
+      {
+        std::lock_guard lock(mutex_);
+        if (jobs_.empty())
+          return;
+        job = std::move(jobs_.front());
+        jobs_.pop_front();
+      }
+      auto& current = slot(job.sequence);
+      try {
+        current.result.clear();
+        current.result.reserve(job.chunk.size());
+        for (auto& item : job.chunk)
+          current.result.push_back(function_(std::move(item)));
+      } catch (...) {
+        current.result.clear();
+        current.error = std::current_exception();
+      }
+      current.state.store(ready);
+      current.state.notify_all();
+    }
+  }
+
+  std::function<Output(Input&&)> function_;
+  unsigned threads_;
+  std::size_t capacity_;
+  std::unique_ptr<Slot[]> slots_;
+  std::counting_semaphore<> free_slots_;
+  std::counting_semaphore<> pending_jobs_{ 0 };
+  std::mutex mutex_;
+  std::deque<Job> jobs_;
+  std::size_t submitted_ = 0;
+  std::size_t delivered_ = 0;
+  bool closed_ = false;
+  // Declared last, so that the workers are joined before the state they use
+  // is destroyed.
+  std::vector<std::jthread> workers_;
+};
+
+// Pipeline intersecting pairs of flats. Pairs are moved into the
+// computation, so results reuse the storage of the first operand when they
+// can.
+template<class ScalarT, unsigned AmbientDim, class F>
+Pipeline<std::pair<Affine_space<ScalarT, AmbientDim>,
+                   Affine_space<ScalarT, AmbientDim>>,
+         std::optional<Affine_space<ScalarT, AmbientDim>>>
+intersection_pipeline(F compare, Pipeline_parameters parameters = {})
+{
+  using Aff_space = Affine_space<ScalarT, AmbientDim>;
+  return Pipeline<std::pair<Aff_space, Aff_space>, std::optional<Aff_space>>(
+    [compare](std::pair<Aff_space, Aff_space>&& pair) {
+      return intersection(
+        std::move(pair.first), std::move(pair.second), compare);
+    },
+    parameters);
+}
+
+} // namespace affine
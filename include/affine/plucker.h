@@ -0,0 +1,140 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "affine/affine_fwd.h"
+#include "affine/affine_space.h"
+#include "affine/detail/affine_detail.h"
+#include "affine/detail/capd.h"
+
+namespace affine {
+
+// Line in 3D given by its direction d and moment m = p x d for any point p
+// of the line.
+template<class ScalarT>
+class Plucker_line
+{
+public:
+  using Scalar = ScalarT;
+  using Point = detail::Point<ScalarT, 3>;
+
+  Plucker_line(const Point& direction, const Point& moment)
+    : direction_(direction)
+    , moment_(moment)
+  {
+  }
+
+  explicit Plucker_line(const Affine_space<ScalarT, 3>& line)
+  {
+    if (line.dimension() != 1)
+      throw std::invalid_argument("'line' must be one dimensional");
+    direction_ = line.base(0);
+    moment_ = detail::cross_product(line.point(), direction_);
+  }
+
+  static Plucker_line through(const Point& a, const Point& b)
+  {
+    return Plucker_line(b - a, detail::cross_product(a, b));
+  }
+
+  const Point& direction() const { return direction_; }
+
+  const Point& moment() const { return moment_; }
+
+  // The point of the line nearest to the origin.
+  Point point() const
+  {
+    return detail::cross_product(direction_, moment_) /
+           (direction_ * direction_);
+  }
+
+  template<class F>
+  Affine_space<ScalarT, 3> to_affine_space(F compare) const
+  {
+    return Affine_space<ScalarT, 3>(
+      point(), std::vector{ direction_ }, std::move(compare));
+  }
+
+private:
+  Point direction_{};
+  Point moment_{};
+};
+
+// Permuted inner product; zero iff the lines are coplanar, otherwise its sign
+// tells on which side one line passes the other.
+template<class ScalarT>
+ScalarT
+side(const Plucker_line<ScalarT>& lhs, const Plucker_line<ScalarT>& rhs)
+{
+  return lhs.direction() * rhs.moment() + rhs.direction() * lhs.moment();
+}
+
+template<class ScalarT, class F>
+bool
+coplanar(const Plucker_line<ScalarT>& lhs,
+         const Plucker_line<ScalarT>& rhs,
+         F compare)
+{
+  return compare(side(lhs, rhs), 0);
+}
+
+template<class ScalarT, class F>
+bool
+intersects(const Plucker_line<ScalarT>& lhs,
+           const Plucker_line<ScalarT>& rhs,
+           F compare)
+{
+  if (!coplanar(lhs, rhs, compare))
+    return false;
+  const auto& d_1 = lhs.direction();
+  const auto& d_2 = rhs.direction();
+  if (!compare(capd::vectalg::euclNorm(detail::cross_product(d_1, d_2)), 0))
+    return true;
+  return compare(capd::vectalg::euclNorm(lhs.moment() * (d_1 * d_2) -
+                                         rhs.moment() * (d_1 * d_1)),
+                 0);
+}
+
+// Structure of arrays of Plucker coordinates for batched side tests.
+template<class ScalarT>
+struct Plucker_lines
+{
+  std::vector<ScalarT> dx, dy, dz;
+  std::vector<ScalarT> mx, my, mz;
+
+  std::size_t size() const { return dx.size(); }
+
+  void push_back(const Plucker_line<ScalarT>& line)
+  {
+    dx.push_back(line.direction()[0]);
+    dy.push_back(line.direction()[1]);
+    dz.push_back(line.direction()[2]);
+    mx.push_back(line.moment()[0]);
+    my.push_back(line.moment()[1]);
+    mz.push_back(line.moment()[2]);
+  }
+};
+
+template<class ScalarT>
+void
+side(const Plucker_line<ScalarT>& line,
+     const Plucker_lines<ScalarT>& lines,
+     std::span<ScalarT> result)
+{
+  if (result.size() < lines.size())
+    throw std::invalid_argument("'result' is smaller than 'lines'");
+  const ScalarT dx = line.direction()[0];
+  const ScalarT dy = line.direction()[1];
+  const ScalarT dz = line.direction()[2];
+  const ScalarT mx = line.moment()[0];
+  const ScalarT my = line.moment()[1];
+  const ScalarT mz = line.moment()[2];
+  for (std::size_t i = 0; i < lines.size(); ++i)
+    result[i] = dx * lines.mx[i] + dy * lines.my[i] + dz * lines.mz[i] +
+                mx * lines.dx[i] + my * lines.dy[i] + mz * lines.dz[i];
+}
+
+} // namespace affine
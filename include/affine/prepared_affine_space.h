@@ -0,0 +1,91 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#include "affine/affine_fwd.h"
+#include "affine/affine_space.h"
+#include "affine/detail/affine_detail.h"
+#include "affine/detail/capd.h"
+#include "affine/detail/prepared_detail.h"
+
+namespace affine {
+
+// Read-only view of an Affine_space optimized for repeated queries.
+// Stores whichever of the base and its orthogonal complement is shorter
+// as a contiguous, cache-line aligned row-major matrix.
+template<class ScalarT, unsigned AmbientDim>
+class Prepared_affine_space
+{
+public:
+  using Scalar = ScalarT;
+  using Point = detail::Point<ScalarT, AmbientDim>;
+
+  template<class F>
+  explicit Prepared_affine_space(
+    const Affine_space<ScalarT, AmbientDim>& affine_space,
+    F compare)
+    : particular_point_(affine_space.point())
+    , dimension_(affine_space.dimension())
+    , complement_(
+        detail::prefers_complement(affine_space.dimension(), AmbientDim))
+  {
+    const auto rows = detail::prepared_rows(affine_space, std::move(compare));
+    rows_count_ = rows.size();
+    for (std::size_t i = 0; i < rows_count_; ++i)
+      for (std::size_t j = 0; j < AmbientDim; ++j)
+        rows_[i * AmbientDim + j] = rows[i][j];
+  }
+
+  constexpr std::size_t ambient_dimension() const { return AmbientDim; }
+
+  std::size_t dimension() const { return dimension_; }
+
+  const Point& point() const { return particular_point_; }
+
+  bool uses_complement() const { return complement_; }
+
+  template<class F>
+  bool element(const Point& point, F compare) const
+  {
+    return compare(distance(point), 0);
+  }
+
+  Point projection(const Point& point) const
+  {
+    const auto diff = point - particular_point_;
+    auto result = complement_ ? point : particular_point_;
+    for (std::size_t i = 0; i < rows_count_; ++i) {
+      const auto c = detail::row_product(row(i), diff);
+      const auto sign = complement_ ? -c : c;
+      for (std::size_t j = 0; j < AmbientDim; ++j)
+        result[j] += sign * rows_[i * AmbientDim + j];
+    }
+    return result;
+  }
+
+  Scalar distance(const Point& point) const
+  {
+    const auto diff = point - particular_point_;
+    Point coefficients{};
+    for (std::size_t i = 0; i < rows_count_; ++i)
+      coefficients[i] = detail::row_product(row(i), diff);
+    return detail::prepared_distance(
+      complement_, rows_.data(), rows_count_, coefficients, diff);
+  }
+
+private:
+  const ScalarT* row(std::size_t i) const
+  {
+    return rows_.data() + i * AmbientDim;
+  }
+
+  Point particular_point_{};
+  std::size_t dimension_ = 0;
+  bool complement_ = false;
+  std::size_t rows_count_ = 0;
+  alignas(64) std::array<ScalarT, AmbientDim / 2 * AmbientDim> rows_{};
+};
+
+} // namespace affine
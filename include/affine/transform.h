@@ -0,0 +1,58 @@
+#pragma once
+
+#include <ranges>
+#include <utility>
+
+#include "affine/affine_space.h"
+
+namespace affine {
+
+namespace detail {
+
+// Lets the batched transform hand the conformality of the map, decided once
+// for the batch, to every flat.
+struct Transform_access
+{
+  template<class ScalarT, unsigned AmbientDim, class F>
+  static void transform(
+    Affine_space<ScalarT, AmbientDim>& affine_space,
+    const typename Affine_space<ScalarT, AmbientDim>::Matrix& map,
+    const typename Affine_space<ScalarT, AmbientDim>::Point& translation,
+    bool conformal_map,
+    F compare)
+  {
+    affine_space.transform_impl(
+      map, translation, conformal_map, std::move(compare));
+  }
+};
+
+} // namespace detail
+
+template<class ScalarT, unsigned AmbientDim, class F>
+Affine_space<ScalarT, AmbientDim>
+transform(Affine_space<ScalarT, AmbientDim> affine_space,
+          const typename Affine_space<ScalarT, AmbientDim>::Matrix& map,
+          const typename Affine_space<ScalarT, AmbientDim>::Point& translation,
+          F compare)
+{
+  affine_space.transform(map, translation, std::move(compare));
+  return affine_space;
+}
+
+// Transforms every space of 'spaces' in place, reusing their storage.
+// Whether 'map' is conformal is decided once for the whole batch.
+template<std::ranges::forward_range R, class F>
+  requires detail::Is_affine_space<std::ranges::range_value_t<R>>::value
+void
+transform(R&& spaces,
+          const typename std::ranges::range_value_t<R>::Matrix& map,
+          const typename std::ranges::range_value_t<R>::Point& translation,
+          F compare)
+{
+  const auto conformal_map = detail::conformal(map, compare);
+  for (auto& affine_space : spaces)
+    detail::Transform_access::transform(
+      affine_space, map, translation, conformal_map, compare);
+}
+
+} // namespace affine
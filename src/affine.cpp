@@ -0,0 +1,3 @@
+#include "affine/detail/explicit_instantiations.h"
+
+AFFINE_INSTANTIATE_ALL()
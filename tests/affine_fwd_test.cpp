@@ -0,0 +1,32 @@
+#include <gtest/gtest.h>
+
+#include <type_traits>
+
+// Only the declarations of affine_fwd.h are visible for the intersection;
+// its instantiation comes from the affine library.
+#include "affine/affine_fwd.h"
+#include "affine/affine_space.h"
+#include "affine/comparisons.h"
+
+static_assert(
+  std::is_same_v<affine::Compact_affine_space<double, 3>,
+                 affine::Compact_affine_space<double, 3, double>>);
+
+TEST(AffineFwdTest, intersectionFromLibrary)
+{
+  using Point = affine::Affine_space<double, 3>::Point;
+  const auto plane = affine::Affine_space<double, 3>::spanning_space(
+    { Point{ 0.0, 0.0, 0.0 }, Point{ 1.0, 0.0, 0.0 }, Point{ 0.0, 1.0, 0.0 } },
+    affine::Equal_to_precision());
+  const auto line = affine::Affine_space<double, 3>::spanning_space(
+    { Point{ 1.0, 1.0, -1.0 }, Point{ 1.0, 1.0, 1.0 } },
+    affine::Equal_to_precision());
+
+  const auto point =
+    affine::intersection(plane, line, affine::Equal_to_precision(1e-14));
+  ASSERT_TRUE(point.has_value());
+  EXPECT_EQ(point->dimension(), 0);
+  EXPECT_NEAR(point->point()[0], 1.0, 1e-14);
+  EXPECT_NEAR(point->point()[1], 1.0, 1e-14);
+  EXPECT_NEAR(point->point()[2], 0.0, 1e-14);
+}
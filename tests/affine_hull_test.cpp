@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+
+#include <functional>
+#include <vector>
+
+// skips -Woverloaded-virtual warnings for capd library
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Woverloaded-virtual"
+#include <capd/capdlib.h>
+#pragma GCC diagnostic pop
+
+#include "affine/affine.h"
+#include "./test_utils.h"
+
+TEST(AffineHullTest, twoSpaces)
+{
+  const Point3D p0{ 1.0, 0.0, 0.0 };
+  const Point3D p1{ 0.0, 1.0, 1.0 };
+  const Point3D p2{ 0.0, 0.0, 0.0 };
+  const Point3D p3{ 1.0, 1.0, 1.0 };
+  const Point3D p4{ 0.0, 0.0, 1.0 };
+  using Aff_space = affine::Affine_space<double, 3>;
+  const auto line0 =
+    Aff_space::spanning_space({ p0, p1 }, affine::Equal_to_precision());
+  const auto line1 =
+    Aff_space::spanning_space({ p2, p3 }, affine::Equal_to_precision());
+  const auto line2 =
+    Aff_space::spanning_space({ p2, p4 }, affine::Equal_to_precision());
+  const auto parallel = Aff_space::spanning_space(
+    { p0 + p4, p1 + p4 }, affine::Equal_to_precision());
+
+  const auto plane =
+    affine::affine_hull(line0, line1, affine::Equal_to_precision());
+  const auto full =
+    affine::affine_hull(line0, line2, affine::Equal_to_precision());
+  const auto strip =
+    affine::affine_hull(line0, parallel, affine::Equal_to_precision());
+  const auto same = affine::affine_hull(
+    line0, Aff_space(0.5 * (p0 + p1)), affine::Equal_to_precision(1e-14));
+  EXPECT_EQ(plane.dimension(), 2);
+  EXPECT_PRED3(element_test, plane, p0, affine::Equal_to_precision(1e-14));
+  EXPECT_PRED3(element_test, plane, p3, affine::Equal_to_precision(1e-14));
+  EXPECT_NEAR(plane.base(0) * plane.base(1), 0, 1e-15);
+  EXPECT_EQ(full.dimension(), 3);
+  EXPECT_EQ(strip.dimension(), 2);
+  EXPECT_PRED3(
+    element_test, strip, p1 + p4, affine::Equal_to_precision(1e-14));
+  EXPECT_EQ(same.dimension(), 1);
+}
+
+TEST(AffineHullTest, range)
+{
+  const Point4D p0{ 0.491742, -4.73389, -6.07428, 0.246362 };
+  const Point4D p1{ -4.85797, 6.30975, -0.959427, -5.05184 };
+  const Point4D p2{ -3.53352, 6.14748, 6.88908, -8.43334 };
+  const Point4D p3{ -7.37983, -0.708072, -0.999901, -9.75365 };
+  using Aff_space = affine::Affine_space<double, 4>;
+  const std::vector spaces{ Aff_space(p0), Aff_space(p1), Aff_space(p2) };
+
+  const auto hull = affine::affine_hull(spaces, affine::Equal_to_precision());
+  const auto expected =
+    Aff_space::spanning_space({ p0, p1, p2 }, affine::Equal_to_precision());
+  EXPECT_EQ(hull.dimension(), expected.dimension());
+  EXPECT_TRUE(equivalent(hull, expected, affine::Equal_to_precision(1e-13)));
+  EXPECT_PRED3(std::not_fn(element_test),
+               hull,
+               p3,
+               affine::Equal_to_precision(1e-13));
+  EXPECT_THROW(
+    affine::affine_hull(std::vector<Aff_space>{}, affine::Equal_to_precision()),
+    std::invalid_argument);
+}
@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+// skips -Woverloaded-virtual warnings for capd library
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Woverloaded-virtual"
+#include <capd/capdlib.h>
+#pragma GCC diagnostic pop
+
+#include "affine/affine.h"
+#include "affine/arrangement.h"
+#include "./test_utils.h"
+
+TEST(ArrangementTest, cube)
+{
+  using Aff_space = affine::Affine_space<double, 3>;
+  const Point3D e0{ 1.0, 0.0, 0.0 };
+  const Point3D e1{ 0.0, 1.0, 0.0 };
+  const Point3D e2{ 0.0, 0.0, 1.0 };
+  const Point3D origin{ 0.0, 0.0, 0.0 };
+  std::vector<Aff_space> planes{
+    Aff_space(origin, std::vector{ e1, e2 }, affine::Equal_to_precision()),
+    Aff_space(e0, std::vector{ e1, e2 }, affine::Equal_to_precision()),
+    Aff_space(origin, std::vector{ e0, e2 }, affine::Equal_to_precision()),
+    Aff_space(e1, std::vector{ e0, e2 }, affine::Equal_to_precision()),
+    Aff_space(origin, std::vector{ e0, e1 }, affine::Equal_to_precision()),
+    Aff_space(e2, std::vector{ e0, e1 }, affine::Equal_to_precision()),
+  };
+
+  const auto cube =
+    affine::arrangement_vertices(planes, affine::Equal_to_precision(1e-12));
+  EXPECT_EQ(cube.size(), 8);
+  for (auto&& vertex : cube)
+    EXPECT_EQ(vertex.hyperplanes.size(), 3);
+
+  planes.push_back(Aff_space(
+    origin, std::vector{ e0 - e1, e1 - e2 }, affine::Equal_to_precision()));
+  const auto vertices = affine::arrangement_vertices(
+    planes, affine::Equal_to_precision(1e-12), { .threads = 3 });
+  EXPECT_EQ(vertices.size(), 17);
+  const auto at_origin =
+    std::ranges::find_if(vertices, [&origin](auto&& vertex) {
+      return capd::vectalg::euclNorm(vertex.point - origin) < 1e-12;
+    });
+  ASSERT_NE(at_origin, vertices.end());
+  EXPECT_EQ(at_origin->hyperplanes,
+            (std::vector<std::size_t>{ 0, 2, 4, 6 }));
+}
+
+TEST(ArrangementTest, hyperplanes4D)
+{
+  using Aff_space = affine::Affine_space<double, 4>;
+  std::vector<Aff_space> hyperplanes;
+  for (unsigned i = 0; i < 4; ++i) {
+    std::vector<Point4D> base;
+    for (unsigned j = 0; j < 4; ++j)
+      if (j != i) {
+        base.emplace_back();
+        base.back()[j] = 1.0;
+      }
+    Point4D point;
+    point[i] = i + 1.0;
+    hyperplanes.emplace_back(point, base, affine::Equal_to_precision());
+  }
+
+  const auto vertices = affine::arrangement_vertices(
+    hyperplanes, affine::Equal_to_precision(1e-12));
+  ASSERT_EQ(vertices.size(), 1);
+  EXPECT_EQ(vertices[0].point, (Point4D{ 1.0, 2.0, 3.0, 4.0 }));
+  EXPECT_THROW(affine::arrangement_vertices(
+                 std::vector{ Aff_space() }, affine::Equal_to_precision()),
+               std::invalid_argument);
+}
+
+TEST(ArrangementTest, largeCoordinates)
+{
+  using Aff_space = affine::Affine_space<double, 2>;
+  const Point2D e0{ 1.0, 0.0 };
+  const Point2D e1{ 0.0, 1.0 };
+  const std::vector<Aff_space> lines{
+    Aff_space(1e10 * e0, std::vector{ e1 }, affine::Equal_to_precision()),
+    Aff_space(2e10 * e0, std::vector{ e1 }, affine::Equal_to_precision()),
+    Aff_space(1e10 * e1, std::vector{ e0 }, affine::Equal_to_precision()),
+  };
+
+  const auto vertices =
+    affine::arrangement_vertices(lines, affine::Equal_to_precision());
+  ASSERT_EQ(vertices.size(), 2);
+  EXPECT_EQ(vertices[0].hyperplanes, (std::vector<std::size_t>{ 0, 2 }));
+  EXPECT_EQ(vertices[1].hyperplanes, (std::vector<std::size_t>{ 1, 2 }));
+}
+
+TEST(ArrangementTest, exceptionInWorker)
+{
+  using Aff_space = affine::Affine_space<double, 3>;
+  std::vector<Aff_space> planes;
+  for (int i = 0; i < 20; ++i) {
+    const Point3D normal{ 1.0, i / 7.0, (i % 5) / 3.0 };
+    Point3D u{ -normal[1], normal[0], 0.0 };
+    const Point3D v{ normal[1] * u[2] - normal[2] * u[1],
+                     normal[2] * u[0] - normal[0] * u[2],
+                     normal[0] * u[1] - normal[1] * u[0] };
+    planes.emplace_back(Point3D{ i / 2.0, 0.0, 0.0 },
+                        std::vector{ u, v },
+                        affine::Equal_to_precision());
+  }
+  // Throws only on the pool threads, which without the rethrow would
+  // terminate the process. The calling thread is slowed down, so that it
+  // does not take every first index before the pool threads start.
+  const auto caller = std::this_thread::get_id();
+  const auto compare = [caller](const auto& lhs, const auto& rhs) {
+    if (std::this_thread::get_id() != caller)
+      throw std::runtime_error("compare failed");
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+    return affine::Equal_to_precision(1e-12)(lhs, rhs);
+  };
+
+  EXPECT_THROW(
+    affine::arrangement_vertices(planes, compare, { .threads = 4 }),
+    std::runtime_error);
+  EXPECT_THROW(affine::arrangement_vertices(
+                 planes, [](const auto&, const auto&) { return true; }),
+               std::invalid_argument);
+}
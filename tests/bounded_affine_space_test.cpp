@@ -0,0 +1,208 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <functional>
+#include <numbers>
+#include <vector>
+
+// skips -Woverloaded-virtual warnings for capd library
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Woverloaded-virtual"
+#include <capd/capdlib.h>
+#pragma GCC diagnostic pop
+
+#include "affine/affine.h"
+#include "./test_utils.h"
+
+using Bounded2D = affine::Bounded_affine_space<double, 2>;
+using Bounded3D = affine::Bounded_affine_space<double, 3>;
+
+TEST(BoundedAffineSpaceTest, segmentWithSegment)
+{
+  const auto segment0 = Bounded2D::segment(
+    Point2D{ 0.0, 0.0 }, Point2D{ 2.0, 2.0 }, affine::Equal_to_precision());
+  const auto segment1 = Bounded2D::segment(
+    Point2D{ 0.0, 2.0 }, Point2D{ 2.0, 0.0 }, affine::Equal_to_precision());
+  const auto segment2 = Bounded2D::segment(
+    Point2D{ 3.0, 0.0 }, Point2D{ 4.0, -1.0 }, affine::Equal_to_precision());
+
+  const Point2D on_segment{ 1.5, 1.5 };
+  const Point2D past_segment{ 2.5, 2.5 };
+  EXPECT_PRED3(
+    element_test, segment0, on_segment, affine::Equal_to_precision());
+  EXPECT_PRED3(std::not_fn(element_test),
+               segment0,
+               past_segment,
+               affine::Equal_to_precision());
+
+  const auto intersection0 =
+    intersection(segment0, segment1, affine::Equal_to_precision(1e-14));
+  const auto intersection1 =
+    intersection(segment0, segment2, affine::Equal_to_precision(1e-14));
+  EXPECT_PRED1(has_value_test, intersection0);
+  EXPECT_EQ(intersection0->dimension(), 0);
+  EXPECT_NEAR(intersection0->affine_space().point()[0], 1.0, 1e-14);
+  EXPECT_NEAR(intersection0->affine_space().point()[1], 1.0, 1e-14);
+  EXPECT_PRED1(std::not_fn(has_value_test), intersection1);
+}
+
+TEST(BoundedAffineSpaceTest, lineWithTriangle)
+{
+  const std::vector<Point3D> triangle{ { 1.0, 0.0, 0.0 },
+                                       { 0.0, 1.0, 0.0 },
+                                       { 0.0, 0.0, 1.0 } };
+  const auto polygon =
+    Bounded3D::polygon(triangle, affine::Equal_to_precision());
+  const auto inside = affine::Affine_space<double, 3>::spanning_space(
+    { Point3D{ 0.0, 0.0, 0.0 }, Point3D{ 1.0, 1.0, 1.0 } },
+    affine::Equal_to_precision());
+  const auto outside = affine::Affine_space<double, 3>::spanning_space(
+    { Point3D{ 1.0, 1.0, 0.0 }, Point3D{ 1.0, 1.0, 1.0 } },
+    affine::Equal_to_precision());
+
+  EXPECT_EQ(polygon.constraints().size(), 3);
+  const Point3D in_triangle{ 0.25, 0.25, 0.5 };
+  const Point3D out_of_triangle{ 1.0, 1.0, -1.0 };
+  EXPECT_PRED3(element_test,
+               polygon,
+               in_triangle,
+               affine::Equal_to_precision(1e-14));
+  EXPECT_PRED3(std::not_fn(element_test),
+               polygon,
+               out_of_triangle,
+               affine::Equal_to_precision(1e-14));
+  const auto hit =
+    intersection(polygon, inside, affine::Equal_to_precision(1e-14));
+  EXPECT_PRED1(has_value_test, hit);
+  EXPECT_NEAR(hit->affine_space().point()[0], 1.0 / 3.0, 1e-14);
+  EXPECT_PRED1(
+    std::not_fn(has_value_test),
+    intersection(polygon, outside, affine::Equal_to_precision(1e-14)));
+}
+
+TEST(BoundedAffineSpaceTest, planeWithPlane)
+{
+  const std::vector<Point3D> square0{ { -1.0, -1.0, 0.0 },
+                                      { 1.0, -1.0, 0.0 },
+                                      { 1.0, 1.0, 0.0 },
+                                      { -1.0, 1.0, 0.0 } };
+  const std::vector<Point3D> square1{ { 0.5, -1.0, -1.0 },
+                                      { 0.5, 1.0, -1.0 },
+                                      { 0.5, 1.0, 1.0 },
+                                      { 0.5, -1.0, 1.0 } };
+  const std::vector<Point3D> square2{ { 3.0, -1.0, -1.0 },
+                                      { 3.0, 1.0, -1.0 },
+                                      { 3.0, 1.0, 1.0 },
+                                      { 3.0, -1.0, 1.0 } };
+  const auto polygon0 =
+    Bounded3D::polygon(square0, affine::Equal_to_precision());
+  const auto polygon1 =
+    Bounded3D::polygon(square1, affine::Equal_to_precision());
+  const auto polygon2 =
+    Bounded3D::polygon(square2, affine::Equal_to_precision());
+
+  const auto segment =
+    intersection(polygon0, polygon1, affine::Equal_to_precision(1e-14));
+  EXPECT_PRED1(has_value_test, segment);
+  EXPECT_EQ(segment->dimension(), 1);
+  const Point3D on_segment{ 0.5, 0.75, 0.0 };
+  const Point3D past_segment{ 0.5, 1.5, 0.0 };
+  EXPECT_PRED3(element_test,
+               *segment,
+               on_segment,
+               affine::Equal_to_precision(1e-14));
+  EXPECT_PRED3(std::not_fn(element_test),
+               *segment,
+               past_segment,
+               affine::Equal_to_precision(1e-14));
+  EXPECT_PRED1(
+    std::not_fn(has_value_test),
+    intersection(polygon0, polygon2, affine::Equal_to_precision(1e-14)));
+}
+
+TEST(BoundedAffineSpaceTest, polygonWithCollinearVertices)
+{
+  const std::vector<Point3D> square{ { 0.0, 0.0, 0.0 },
+                                     { 1.0, 0.0, 0.0 },
+                                     { 2.0, 0.0, 0.0 },
+                                     { 2.0, 2.0, 0.0 },
+                                     { 0.0, 2.0, 0.0 } };
+  const auto polygon = Bounded3D::polygon(square, affine::Equal_to_precision());
+  const auto reversed = Bounded3D::polygon(std::vector<Point3D>(square.rbegin(),
+                                                                square.rend()),
+                                           affine::Equal_to_precision());
+  const auto line = affine::Affine_space<double, 3>::spanning_space(
+    { Point3D{ 1.0, 1.0, -1.0 }, Point3D{ 1.0, 1.0, 1.0 } },
+    affine::Equal_to_precision());
+
+  const Point3D in_square{ 1.0, 1.0, 0.0 };
+  const Point3D out_of_square{ 1.0, -1.0, 0.0 };
+  EXPECT_PRED3(
+    element_test, polygon, in_square, affine::Equal_to_precision(1e-14));
+  EXPECT_PRED3(std::not_fn(element_test),
+               polygon,
+               out_of_square,
+               affine::Equal_to_precision(1e-14));
+  EXPECT_PRED3(
+    element_test, reversed, in_square, affine::Equal_to_precision(1e-14));
+  EXPECT_PRED3(std::not_fn(element_test),
+               reversed,
+               out_of_square,
+               affine::Equal_to_precision(1e-14));
+  const auto hit =
+    intersection(line, polygon, affine::Equal_to_precision(1e-14));
+  EXPECT_PRED1(has_value_test, hit);
+  EXPECT_EQ(hit->dimension(), 0);
+  EXPECT_NEAR(hit->affine_space().point()[2], 0.0, 1e-14);
+}
+
+TEST(BoundedAffineSpaceTest, coplanarPolygons)
+{
+  // Regular 128-gons of circumradius 1 in an oblique plane; Fourier-Motzkin
+  // elimination of their 256 edges would take minutes.
+  const Point3D e0 = Point3D{ 1.0, 1.0, 0.0 } / std::sqrt(2.0);
+  const Point3D e1 = Point3D{ -1.0, 1.0, 2.0 } / std::sqrt(6.0);
+  const Point3D origin{ 1.0, 2.0, 3.0 };
+  const auto regular_polygon = [&](double centre) {
+    std::vector<Point3D> vertices;
+    for (int i = 0; i < 128; ++i) {
+      const auto angle = 2.0 * std::numbers::pi * i / 128;
+      vertices.push_back(origin + (centre + std::cos(angle)) * e0 +
+                         std::sin(angle) * e1);
+    }
+    return Bounded3D::polygon(vertices, affine::Equal_to_precision());
+  };
+  const auto polygon = regular_polygon(0.0);
+  const auto overlapping = regular_polygon(1.5);
+  const auto touching = regular_polygon(2.0);
+  const auto apart = regular_polygon(2.5);
+  const auto plane =
+    affine::Affine_space<double, 3>(origin, std::vector{ e0, e1 },
+                                    affine::Equal_to_precision());
+
+  const auto lens =
+    intersection(polygon, overlapping, affine::Equal_to_precision(1e-12));
+  EXPECT_PRED1(has_value_test, lens);
+  EXPECT_EQ(lens->dimension(), 2);
+  const Point3D in_lens = origin + 0.75 * e0 + 0.5 * e1;
+  const Point3D out_of_lens = origin + 0.25 * e0;
+  EXPECT_PRED3(element_test, *lens, in_lens, affine::Equal_to_precision(1e-12));
+  EXPECT_PRED3(std::not_fn(element_test),
+               *lens,
+               out_of_lens,
+               affine::Equal_to_precision(1e-12));
+  EXPECT_PRED1(
+    has_value_test,
+    intersection(polygon, touching, affine::Equal_to_precision(1e-12)));
+  EXPECT_PRED1(
+    std::not_fn(has_value_test),
+    intersection(polygon, apart, affine::Equal_to_precision(1e-12)));
+  const auto in_plane =
+    intersection(plane, polygon, affine::Equal_to_precision(1e-12));
+  EXPECT_PRED1(has_value_test, in_plane);
+  EXPECT_EQ(in_plane->dimension(), 2);
+  EXPECT_PRED3(std::not_fn(element_test),
+               *in_plane,
+               origin + 1.5 * e0,
+               affine::Equal_to_precision(1e-12));
+}
@@ -0,0 +1,148 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <functional>
+#include <thread>
+#include <vector>
+
+// skips -Woverloaded-virtual warnings for capd library
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Woverloaded-virtual"
+#include <capd/capdlib.h>
+#pragma GCC diagnostic pop
+
+#include "affine/affine.h"
+#include "affine/flat_cache.h"
+#include "./test_utils.h"
+
+TEST(CanonicalTest, independentOfConstruction)
+{
+  const Point3D p0{ 3.0, -1.0, -2.0 };
+  const Point3D p1{ 4.0, 8.0, 3.0 };
+  const Point3D p2{ -12.0, 6.0, 6.0 };
+  const auto space0 = affine::Affine_space<double, 3>::spanning_space(
+    { p0, p1, p2 }, affine::Equal_to_precision());
+  const auto space1 = affine::Affine_space<double, 3>::spanning_space(
+    { p2, 0.5 * (p0 + p1), p1 }, affine::Equal_to_precision());
+  const auto canonical0 = canonical(space0, affine::Equal_to_precision());
+  const auto canonical1 = canonical(space1, affine::Equal_to_precision());
+
+  EXPECT_TRUE(equivalent(space0, space1, affine::Equal_to_precision(1e-13)));
+  EXPECT_TRUE(
+    equivalent(space0, canonical0, affine::Equal_to_precision(1e-13)));
+  EXPECT_NEAR(canonical0.point() * canonical0.base(0), 0, 1e-13);
+  EXPECT_NEAR(canonical0.point() * canonical0.base(1), 0, 1e-13);
+  for (std::size_t i = 0; i < 3; ++i) {
+    EXPECT_NEAR(canonical0.point()[i], canonical1.point()[i], 1e-13);
+    EXPECT_NEAR(canonical0.base(0)[i], canonical1.base(0)[i], 1e-13);
+    EXPECT_NEAR(canonical0.base(1)[i], canonical1.base(1)[i], 1e-13);
+  }
+  EXPECT_EQ(hash_value(space0, 1e-6, affine::Equal_to_precision()),
+            hash_value(space1, 1e-6, affine::Equal_to_precision()));
+  EXPECT_FALSE(
+    equivalent(space0,
+               affine::Affine_space<double, 3>::spanning_space(
+                 { p0, p1 }, affine::Equal_to_precision()),
+               affine::Equal_to_precision()));
+}
+
+TEST(CanonicalTest, hashOfLargeCoordinates)
+{
+  const Point3D p0{ 1e10, 0.0, 0.0 };
+  const Point3D p1{ 2e10, 0.0, 0.0 };
+  const affine::Affine_space<double, 3> space0(p0);
+  const affine::Affine_space<double, 3> space1(p1);
+
+  EXPECT_NE(hash_value(space0, 1e-9, affine::Equal_to_precision()),
+            hash_value(space1, 1e-9, affine::Equal_to_precision()));
+  EXPECT_EQ(hash_value(space0, 1e-9, affine::Equal_to_precision()),
+            hash_value(affine::Affine_space<double, 3>(p0),
+                       1e-9,
+                       affine::Equal_to_precision()));
+}
+
+TEST(CanonicalTest, flatCache)
+{
+  const Point3D p0{ 7.06976, 3.01336, 0.573289 };
+  const Point3D p1{ 0.555447, 9.69536, -1.08835 };
+  const Point3D p2{ -3.03373, 3.06169, -5.20502 };
+  const Point3D p3{ -2.43233, -8.75036, 4.67991 };
+  const Point3D p4{ 5.13406, -5.94389, 1.66657 };
+  const Point3D p5{ -0.629713, 0.869835, -4.97337 };
+  const auto space0 = affine::Affine_space<double, 3>::spanning_space(
+    { p0, p1, p2 }, affine::Equal_to_precision());
+  const auto space1 = affine::Affine_space<double, 3>::spanning_space(
+    { p3, p4, p5 }, affine::Equal_to_precision());
+  const auto space0_reordered = affine::Affine_space<double, 3>::spanning_space(
+    { p2, p0, p1 }, affine::Equal_to_precision());
+  affine::Flat_cache<double, 3, affine::Equal_to_precision> cache(
+    affine::Equal_to_precision(1e-12), 1e-6, 8);
+
+  const auto interned = cache.intern(space0);
+  EXPECT_EQ(cache.intern(space0_reordered).point(), interned.point());
+  EXPECT_EQ(cache.size(), 1);
+
+  std::vector<std::jthread> threads;
+  for (int i = 0; i < 4; ++i)
+    threads.emplace_back([&] {
+      for (int j = 0; j < 16; ++j) {
+        const auto intersection = cache.intersection(
+          j % 2 ? space0 : space0_reordered, space1);
+        EXPECT_PRED1(has_value_test, intersection);
+        EXPECT_EQ(intersection->dimension(), 1);
+      }
+    });
+  threads.clear();
+  EXPECT_EQ(cache.size(), 2);
+  const auto intersection = cache.intersection(space1, space0);
+  EXPECT_PRED3(element_test,
+               space0,
+               intersection->point(),
+               affine::Equal_to_precision(1e-13));
+  EXPECT_EQ(cache.size(), 2);
+}
+
+TEST(CanonicalTest, obliqueFlatsThroughOriginInAnyOrder)
+{
+  const Point3D direction{ 1.0, 1.0, 1.0 };
+  const Point3D other{ 1.0, -2.0, 0.5 };
+  affine::Flat_cache<double, 3, affine::Equal_to_precision> lines(
+    affine::Equal_to_precision(1e-12), 1e-9, 8);
+  affine::Flat_cache<double, 3, affine::Equal_to_precision> planes(
+    affine::Equal_to_precision(1e-12), 1e-9, 8);
+  for (int i = -20; i <= 20; ++i) {
+    for (int j = -20; j <= 20; ++j) {
+      if (7 * i == 3 * j)
+        continue;
+      const auto a = (i / 3.0) * direction;
+      const auto b = (j / 7.0) * direction;
+      const auto forward = affine::Affine_space<double, 3>::spanning_space(
+        { a, b }, affine::Equal_to_precision());
+      const auto backward = affine::Affine_space<double, 3>::spanning_space(
+        { b, a }, affine::Equal_to_precision());
+      const auto keys =
+        hash_values(forward, 1e-9, affine::Equal_to_precision());
+      EXPECT_NE(
+        std::ranges::find(
+          keys, hash_value(backward, 1e-9, affine::Equal_to_precision())),
+        keys.end());
+      lines.intern(forward);
+      lines.intern(backward);
+
+      const auto c = a + (j / 5.0) * other;
+      const auto plane0 = affine::Affine_space<double, 3>::spanning_space(
+        { a, b, c }, affine::Equal_to_precision());
+      const auto plane1 = affine::Affine_space<double, 3>::spanning_space(
+        { c, a, b }, affine::Equal_to_precision());
+      const auto plane2 = affine::Affine_space<double, 3>::spanning_space(
+        { b, c, a }, affine::Equal_to_precision());
+      if (plane0.dimension() != 2)
+        continue;
+      planes.intern(plane0);
+      planes.intern(plane1);
+      planes.intern(plane2);
+    }
+  }
+  EXPECT_EQ(lines.size(), 1);
+  EXPECT_EQ(planes.size(), 1);
+}
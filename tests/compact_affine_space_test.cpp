@@ -0,0 +1,150 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <functional>
+#include <vector>
+
+// skips -Woverloaded-virtual warnings for capd library
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Woverloaded-virtual"
+#include <capd/capdlib.h>
+#pragma GCC diagnostic pop
+
+#include "affine/affine.h"
+#include "./test_utils.h"
+
+namespace {
+
+inline constexpr auto equivalent_test =
+  [](auto&& lhs, auto&& rhs, auto&& compare) {
+    return affine::equivalent(lhs, rhs, compare);
+  };
+
+} // namespace
+
+TEST(CompactAffineSpaceTest, roundTrip)
+{
+  const Point3D p0{ 1.0, 2.0, 3.0 };
+  const Point3D p1{ 2.0, -1.0, 0.5 };
+  const Point3D p2{ -3.0, 0.0, 4.0 };
+  const auto plane = affine::Affine_space<double, 3>::spanning_space(
+    { p0, p1, p2 }, affine::Equal_to_precision());
+  const auto line = affine::Affine_space<double, 3>::spanning_space(
+    { p0, p1 }, affine::Equal_to_precision());
+  const affine::Affine_space<double, 3> point(p2);
+
+  const affine::Compact_affine_space compact_plane(
+    plane, affine::Equal_to_precision());
+  const affine::Compact_affine_space compact_line(
+    line, affine::Equal_to_precision());
+  const affine::Compact_affine_space compact_point(
+    point, affine::Equal_to_precision());
+  EXPECT_EQ(compact_plane.dimension(), 2);
+  EXPECT_EQ(compact_line.dimension(), 1);
+  EXPECT_EQ(compact_point.dimension(), 0);
+  EXPECT_PRED3(equivalent_test,
+               compact_plane.to_affine_space(affine::Equal_to_precision()),
+               plane,
+               affine::Equal_to_precision(1e-13));
+  EXPECT_PRED3(equivalent_test,
+               compact_line.to_affine_space(affine::Equal_to_precision()),
+               line,
+               affine::Equal_to_precision(1e-13));
+  EXPECT_PRED3(equivalent_test,
+               compact_point.to_affine_space(affine::Equal_to_precision()),
+               point,
+               affine::Equal_to_precision(1e-13));
+
+  const auto expanded =
+    compact_line.to_affine_space(affine::Equal_to_precision());
+  EXPECT_NEAR(expanded.point() * expanded.base(0), 0, 1e-14);
+  EXPECT_PRED3(
+    element_test, compact_plane, p2, affine::Equal_to_precision(1e-13));
+  EXPECT_PRED3(
+    element_test, compact_line, p1, affine::Equal_to_precision(1e-13));
+  EXPECT_PRED3(std::not_fn(element_test),
+               compact_line,
+               p2,
+               affine::Equal_to_precision(1e-13));
+}
+
+TEST(CompactAffineSpaceTest, distance)
+{
+  const Point3D p0{ 0.0, 0.0, 1.0 };
+  const Point3D p1{ 1.0, 1.0, 1.0 };
+  const Point3D p2{ -1.0, 2.0, 1.0 };
+  const Point3D q{ 3.0, -4.0, 5.0 };
+  const affine::Compact_affine_space plane(
+    affine::Affine_space<double, 3>::spanning_space(
+      { p0, p1, p2 }, affine::Equal_to_precision()),
+    affine::Equal_to_precision());
+  const affine::Compact_affine_space line(
+    affine::Affine_space<double, 3>::spanning_space(
+      { p0, p1 }, affine::Equal_to_precision()),
+    affine::Equal_to_precision());
+
+  EXPECT_NEAR(plane.distance(q), 4.0, 1e-13);
+  // q - p0 == (3, -4, 4) has the component -1 / sqrt(2) along the line.
+  EXPECT_NEAR(line.distance(q), std::sqrt(41.0 - 0.5), 1e-13);
+}
+
+TEST(CompactAffineSpaceTest, quantized)
+{
+  using Compact = affine::Compact_affine_space<double, 4, float>;
+  const Point4D p0{ 0.3, -1.7, 2.2, 0.9 };
+  const Point4D p1{ 1.1, 0.4, -0.6, 2.5 };
+  const Point4D p2{ -2.3, 1.9, 0.7, -0.2 };
+  const auto plane = affine::Affine_space<double, 4>::spanning_space(
+    { p0, p1, p2 }, affine::Equal_to_precision());
+  const Compact compact(plane, affine::Equal_to_precision());
+
+  EXPECT_LE(sizeof(Compact), sizeof(std::size_t) + 6 * sizeof(float));
+  EXPECT_PRED3(element_test, compact, p0, affine::Equal_to_precision(1e-5));
+  EXPECT_PRED3(element_test, compact, p1, affine::Equal_to_precision(1e-5));
+  EXPECT_PRED3(element_test, compact, p2, affine::Equal_to_precision(1e-5));
+  EXPECT_PRED3(equivalent_test,
+               compact.to_affine_space(affine::Equal_to_precision()),
+               plane,
+               affine::Equal_to_precision(1e-5));
+}
+
+TEST(CompactAffineSpaceTest, intersection)
+{
+  const Point4D p0{ 0.0, 0.0, 0.0, 0.0 };
+  const Point4D p1{ 1.0, 0.0, 0.0, 0.0 };
+  const Point4D p2{ 0.0, 1.0, 0.0, 0.0 };
+  const Point4D p3{ 0.0, 0.0, 1.0, 0.0 };
+  const Point4D p4{ 0.0, 0.0, 0.0, 1.0 };
+  const auto plane = affine::Affine_space<double, 4>::spanning_space(
+    { p0, p2, p3 }, affine::Equal_to_precision());
+  const auto hyperplane = affine::Affine_space<double, 4>::spanning_space(
+    { p1, p2, p3, p4 }, affine::Equal_to_precision());
+  const auto parallel = affine::Affine_space<double, 4>::spanning_space(
+    { p1, p1 + p2, p1 + p3 }, affine::Equal_to_precision());
+  const affine::Compact_affine_space compact_plane(
+    plane, affine::Equal_to_precision());
+  const affine::Compact_affine_space compact_hyperplane(
+    hyperplane, affine::Equal_to_precision());
+  const affine::Compact_affine_space compact_parallel(
+    parallel, affine::Equal_to_precision());
+
+  const auto line = affine::intersection(
+    compact_plane, compact_hyperplane, affine::Equal_to_precision());
+  const auto expected =
+    affine::intersection(plane, hyperplane, affine::Equal_to_precision());
+  EXPECT_PRED1(has_value_test, line);
+  EXPECT_EQ(line->dimension(), 1);
+  EXPECT_PRED3(equivalent_test,
+               line->to_affine_space(affine::Equal_to_precision()),
+               *expected,
+               affine::Equal_to_precision(1e-13));
+
+  const auto same = affine::intersection(
+    compact_plane, compact_plane, affine::Equal_to_precision());
+  EXPECT_PRED1(has_value_test, same);
+  EXPECT_EQ(same->dimension(), 2);
+  EXPECT_PRED1(std::not_fn(has_value_test),
+               affine::intersection(compact_plane,
+                                    compact_parallel,
+                                    affine::Equal_to_precision()));
+}
@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+
+#include <functional>
+#include <vector>
+
+// skips -Woverloaded-virtual warnings for capd library
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Woverloaded-virtual"
+#include <capd/capdlib.h>
+#pragma GCC diagnostic pop
+
+#include "affine/affine.h"
+#include "./test_utils.h"
+
+using Coordinate4D = affine::Coordinate_space<double, 4>;
+
+TEST(CoordinateSpaceTest, detection)
+{
+  const Point4D p0{ 1.0, 2.0, 3.0, 4.0 };
+  const Point4D v0{ 0.0, 2.0, 0.0, 0.0 };
+  const Point4D v1{ 0.0, 1.0, 0.0, -3.0 };
+  const Point4D v2{ 1.0, 1.0, 0.0, 0.0 };
+  const affine::Affine_space aligned(
+    p0, std::vector{ v0, v1 }, affine::Equal_to_precision());
+  const affine::Affine_space oblique(
+    p0, std::vector{ v2 }, affine::Equal_to_precision());
+
+  const auto coordinate =
+    Coordinate4D::from(aligned, affine::Equal_to_precision(1e-14));
+  EXPECT_PRED1(has_value_test, coordinate);
+  EXPECT_EQ(coordinate->fixed(), Coordinate4D::Mask("0101"));
+  EXPECT_EQ(coordinate->dimension(), 2);
+  EXPECT_EQ(coordinate->values()[0], 1.0);
+  EXPECT_EQ(coordinate->values()[2], 3.0);
+  EXPECT_PRED1(std::not_fn(has_value_test),
+               Coordinate4D::from(oblique, affine::Equal_to_precision(1e-14)));
+  EXPECT_TRUE(equivalent(coordinate->to_affine_space(),
+                         aligned,
+                         affine::Equal_to_precision(1e-14)));
+}
+
+TEST(CoordinateSpaceTest, elementAndProjection)
+{
+  const Coordinate4D space(Coordinate4D::Mask("1010"),
+                           Point4D{ 0.0, 5.0, 0.0, -1.0 });
+  const Point4D inside{ 7.0, 5.0, -2.0, -1.0 };
+  const Point4D outside{ 7.0, 5.0, -2.0, 0.0 };
+
+  EXPECT_EQ(space.dimension(), 2);
+  EXPECT_PRED3(element_test, space, inside, affine::Equal_to_precision());
+  EXPECT_PRED3(
+    std::not_fn(element_test), space, outside, affine::Equal_to_precision());
+  EXPECT_EQ(space.projection(outside), inside);
+}
+
+TEST(CoordinateSpaceTest, intersection)
+{
+  const Coordinate4D space0(Coordinate4D::Mask("0011"),
+                            Point4D{ 1.0, 2.0, 0.0, 0.0 });
+  const Coordinate4D space1(Coordinate4D::Mask("0110"),
+                            Point4D{ 0.0, 2.0, 3.0, 0.0 });
+  const Coordinate4D space2(Coordinate4D::Mask("0010"),
+                            Point4D{ 0.0, 4.0, 0.0, 0.0 });
+
+  const auto line =
+    intersection(space0, space1, affine::Equal_to_precision());
+  EXPECT_PRED1(has_value_test, line);
+  EXPECT_EQ(line->fixed(), Coordinate4D::Mask("0111"));
+  EXPECT_EQ(line->values(), (Point4D{ 1.0, 2.0, 3.0, 0.0 }));
+  EXPECT_PRED1(std::not_fn(has_value_test),
+               intersection(space0, space2, affine::Equal_to_precision()));
+
+  const auto hyperplane = affine::Affine_space<double, 4>::spanning_space(
+    { Point4D{ 10.0, 0.0, 0.0, 0.0 },
+      Point4D{ 0.0, 10.0, 0.0, 0.0 },
+      Point4D{ 0.0, 0.0, 10.0, 0.0 },
+      Point4D{ 0.0, 0.0, 0.0, 10.0 } },
+    affine::Equal_to_precision());
+  const auto point =
+    intersection(*line, hyperplane, affine::Equal_to_precision(1e-14));
+  EXPECT_PRED1(has_value_test, point);
+  EXPECT_EQ(point->dimension(), 0);
+  EXPECT_NEAR(point->point()[3], 4.0, 1e-14);
+  EXPECT_PRED3(
+    element_test, *line, point->point(), affine::Equal_to_precision(1e-14));
+}
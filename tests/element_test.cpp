@@ -5,6 +5,8 @@
 #include <functional>
 #include <list>
 #include <stdexcept>
+#include <type_traits>
+#include <vector>
 
 // skips -Woverloaded-virtual warnings for capd library
 #pragma GCC diagnostic push
@@ -105,4 +107,28 @@ TEST(ElementTest, plane)
                space,
                p0 + r * p3,
                affine::Equal_to_precision());
-}
\ No newline at end of file
+}
+
+TEST(ElementTest, mixedPrecision)
+{
+  static_assert(std::is_same_v<affine::accumulation_t<float>, double>);
+  const FPoint4D p0{ 0.491742f, -4.73389f, -6.07428f, 0.246362f };
+  const FPoint4D p1{ -4.85797f, 6.30975f, -0.959427f, -5.05184f };
+  const FPoint4D p2{ -3.53352f, 6.14748f, 6.88908f, -8.43334f };
+  const FPoint4D p3{ -7.37983f, -0.708072f, -0.999901f, -9.75365f };
+  const float t = 0.25f;
+  const float s = -0.5f;
+  const affine::Affine_space space(
+    p0, std::vector{ p1, p2 }, affine::Equal_to_precision(1e-6));
+
+  EXPECT_EQ(space.dimension(), 2);
+  EXPECT_NEAR(space.base(0) * space.base(1), 0.0f, 1e-6f);
+  EXPECT_PRED3(element_test,
+               space,
+               p0 + t * p1 + s * p2,
+               affine::Equal_to_precision(1e-5));
+  EXPECT_PRED3(std::not_fn(element_test),
+               space,
+               p0 + t * p3,
+               affine::Equal_to_precision(1e-5));
+}
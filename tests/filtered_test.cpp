@@ -0,0 +1,56 @@
+#include <gtest/gtest.h>
+
+#include <functional>
+#include <vector>
+
+// skips -Woverloaded-virtual warnings for capd library
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Woverloaded-virtual"
+#include <capd/capdlib.h>
+#pragma GCC diagnostic pop
+
+#include "affine/affine.h"
+#include "./test_utils.h"
+
+TEST(FilteredTest, element)
+{
+  const Point3D p0{ 3.0, -1.0, -2.0 };
+  const Point3D p1{ 4.0, 8.0, 3.0 };
+  const Point3D p2{ -12.0, 6.0, 6.0 };
+  const Point3D off_plane{ 1.0, 1.0, 1.0 };
+  const auto space =
+    affine::Filtered_affine_space<3>::spanning_space({ p0, p1, p2 });
+
+  EXPECT_EQ(space.dimension(), 2);
+  EXPECT_TRUE(space.element(p0));
+  EXPECT_TRUE(space.element(p1));
+  EXPECT_TRUE(space.element(0.5 * (p1 + p2)));
+  EXPECT_FALSE(space.element(off_plane));
+  EXPECT_FALSE(space.element(p0 + 1e-6 * off_plane));
+}
+
+TEST(FilteredTest, intersection)
+{
+  const Point2D p0{ 0.0, 1.0 };
+  const Point2D p1{ 1.0, 0.1 };
+  const Point2D p2{ 0.0, 0.0 };
+  const Point2D p3{ 1.0, 1.0 };
+  const Point2D p4{ 1.0, 2.0 };
+  using Filtered = affine::Filtered_affine_space<2>;
+  const auto line0 = Filtered::spanning_space({ p0, p1 });
+  const auto line1 = Filtered::spanning_space({ p2, p3 });
+  const auto line2 = Filtered::spanning_space({ p0, p4 });
+  const auto line3 = Filtered::spanning_space({ p2, 3.0 * p3 });
+
+  const auto crossing = intersection(line0, line1);
+  EXPECT_PRED1(has_value_test, crossing);
+  EXPECT_EQ(crossing->dimension(), 0);
+  EXPECT_PRED3(element_test,
+               line0.approximate(),
+               crossing->point(),
+               affine::Equal_to_precision(1e-14));
+  EXPECT_PRED1(std::not_fn(has_value_test), intersection(line1, line2));
+  const auto same = intersection(line1, line3);
+  EXPECT_PRED1(has_value_test, same);
+  EXPECT_EQ(same->dimension(), 1);
+}
@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <functional>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+// skips -Woverloaded-virtual warnings for capd library
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Woverloaded-virtual"
+#include <capd/capdlib.h>
+#pragma GCC diagnostic pop
+
+#include "affine/affine.h"
+#include "affine/fitting.h"
+#include "./test_utils.h"
+
+TEST(FittingTest, streamingPlane)
+{
+  const Point3D p0{ 1.0, -2.0, 0.5 };
+  const Point3D v0{ 0.6, 0.8, 0.0 };
+  const Point3D v1{ 0.0, 0.0, 1.0 };
+  const Point3D normal{ 0.8, -0.6, 0.0 };
+  std::vector<Point3D> points;
+  for (int i = 0; i < 20; ++i)
+    for (int j = 0; j < 20; ++j)
+      points.push_back(p0 + (i - 10.0) * v0 + (j - 10.0) * v1 +
+                       1e-3 * std::sin(i * 7.0 + j * 3.0) * normal);
+
+  affine::Flat_fitter<double, 3> fitter;
+  const std::span all(points);
+  for (std::size_t offset = 0; offset < all.size(); offset += 64)
+    fitter.add(
+      all.subspan(offset, std::min<std::size_t>(64, all.size() - offset)));
+  const auto plane = fitter.fit(2, affine::Equal_to_precision());
+
+  EXPECT_EQ(fitter.count(), points.size());
+  EXPECT_EQ(plane.dimension(), 2);
+  EXPECT_PRED3(element_test, plane, p0, affine::Equal_to_precision(1e-2));
+  EXPECT_PRED3(element_test,
+               plane,
+               p0 + 5.0 * v0 - 3.0 * v1,
+               affine::Equal_to_precision(1e-2));
+  EXPECT_PRED3(std::not_fn(element_test),
+               plane,
+               p0 + normal,
+               affine::Equal_to_precision(1e-2));
+  EXPECT_THROW(fitter.fit(4, affine::Equal_to_precision()),
+               std::invalid_argument);
+  EXPECT_THROW((affine::Flat_fitter<double, 3>().fit(
+                 1, affine::Equal_to_precision())),
+               std::invalid_argument);
+}
+
+TEST(FittingTest, ransacLine)
+{
+  const Point3D p0{ 0.5, 1.0, -1.0 };
+  const Point3D v{ 1.0, 2.0, 2.0 };
+  std::vector<Point3D> points;
+  for (int i = 0; i < 60; ++i)
+    points.push_back(p0 + (i / 10.0) * v);
+  for (int i = 0; i < 20; ++i)
+    points.push_back(Point3D{ 3.0 * std::sin(i * 1.3),
+                              5.0 * std::cos(i * 0.7),
+                              4.0 * std::sin(i * 2.1) });
+
+  const auto line = affine::ransac(points,
+                                  1,
+                                  affine::Equal_to_precision(1e-6),
+                                  { .iterations = 64, .seed = 7 });
+
+  EXPECT_PRED1(has_value_test, line);
+  EXPECT_EQ(line->dimension(), 1);
+  EXPECT_PRED3(element_test, *line, p0, affine::Equal_to_precision(1e-9));
+  EXPECT_PRED3(
+    element_test, *line, p0 + 3.0 * v, affine::Equal_to_precision(1e-9));
+}
+
+TEST(FittingTest, ransacWorkerException)
+{
+  std::vector<Point3D> points;
+  for (int i = 0; i < 10; ++i)
+    points.push_back(Point3D{ 1.0 * i, 2.0 * i * i, 0.5 });
+  auto throwing_compare = [](double, double) -> bool {
+    throw std::runtime_error("compare");
+  };
+
+  EXPECT_THROW(affine::ransac(points,
+                              1,
+                              throwing_compare,
+                              { .iterations = 16, .threads = 4 }),
+               std::runtime_error);
+}
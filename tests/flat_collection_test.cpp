@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+// skips -Woverloaded-virtual warnings for capd library
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Woverloaded-virtual"
+#include <capd/capdlib.h>
+#pragma GCC diagnostic pop
+
+#include "affine/affine.h"
+#include "./test_utils.h"
+
+TEST(FlatCollectionTest, element)
+{
+  const Point4D p0{ 0.491742, -4.73389, -6.07428, 0.246362 };
+  const Point4D v0{ -4.85797, 6.30975, -0.959427, -5.05184 };
+  const Point4D v1{ -3.53352, 6.14748, 6.88908, -8.43334 };
+  const Point4D v2{ -7.37983, -0.708072, -0.999901, -9.75365 };
+  const std::vector spaces{
+    affine::Affine_space<double, 4>(p0),
+    affine::Affine_space<double, 4>(
+      p0, std::vector{ v0 }, affine::Equal_to_precision()),
+    affine::Affine_space<double, 4>(
+      p0, std::vector{ v0, v1 }, affine::Equal_to_precision()),
+    affine::Affine_space<double, 4>(
+      p0, std::vector{ v0, v1, v2 }, affine::Equal_to_precision()),
+  };
+  affine::Flat_collection<double, 4> collection;
+  for (auto&& space : spaces)
+    collection.push_back(space, affine::Equal_to_precision());
+  std::vector<Point4D> points{ p0,
+                               p0 + 2.0 * v0,
+                               p0 - v0 + 0.5 * v1,
+                               p0 + v0 + v1 - v2,
+                               v0 + v1 + v2 };
+  for (int i = 0; i < 70; ++i)
+    points.push_back(p0 + (i / 7.0) * v0 + (i % 3) * v2);
+
+  EXPECT_EQ(collection.size(), 4);
+  EXPECT_EQ(collection.dimension(3), 3);
+  const auto single =
+    collection.element(points[2], affine::Equal_to_precision(1e-13));
+  EXPECT_EQ(single, (std::vector<std::uint8_t>{ 0, 0, 1, 1 }));
+  const auto all =
+    collection.element(points, affine::Equal_to_precision(1e-12));
+  ASSERT_EQ(all.size(), points.size() * spaces.size());
+  for (std::size_t p = 0; p < points.size(); ++p)
+    for (std::size_t i = 0; i < spaces.size(); ++i)
+      EXPECT_EQ(
+        all[p * spaces.size() + i] != 0,
+        spaces[i].element(points[p], affine::Equal_to_precision(1e-12)))
+        << "point " << p << ", flat " << i;
+}
+
+TEST(FlatCollectionTest, severalTiles)
+{
+  const Point3D p0{ 1.0, -2.0, 0.5 };
+  const Point3D v0{ 1.0, 2.0, 0.0 };
+  const Point3D v1{ 0.0, -1.0, 3.0 };
+  std::vector<affine::Affine_space<double, 3>> spaces;
+  for (int i = 0; i < 50; ++i) {
+    const Point3D shift{ 0.0, 0.0, i / 10.0 };
+    spaces.emplace_back(
+      p0 + shift, std::vector{ v0 }, affine::Equal_to_precision());
+    spaces.emplace_back(
+      p0 + shift, std::vector{ v0, v1 }, affine::Equal_to_precision());
+  }
+  affine::Flat_collection<double, 3> collection;
+  for (auto&& space : spaces)
+    collection.push_back(space, affine::Equal_to_precision());
+  std::vector<Point3D> points;
+  for (int i = 0; i < 100; ++i)
+    points.push_back(p0 + (i / 20.0) * v0 + Point3D{ 0.0, 0.0, i / 10.0 });
+
+  const auto all =
+    collection.element(points, affine::Equal_to_precision(1e-12));
+  ASSERT_EQ(all.size(), points.size() * spaces.size());
+  for (std::size_t p = 0; p < points.size(); ++p)
+    for (std::size_t i = 0; i < spaces.size(); ++i)
+      EXPECT_EQ(
+        all[p * spaces.size() + i] != 0,
+        spaces[i].element(points[p], affine::Equal_to_precision(1e-12)))
+        << "point " << p << ", flat " << i;
+}
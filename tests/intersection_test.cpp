@@ -168,4 +168,78 @@ TEST(IntersectionTest, intervals)
   EXPECT_PRED3(ielement_test_2d, space0, intersection->point(), affine::IApprox_equal());
   EXPECT_PRED3(ielement_test_2d, space1, intersection->point(), affine::IApprox_equal());
   EXPECT_EQ(intersection->dimension(), 0);
-}
\ No newline at end of file
+}
+
+TEST(IntersectionTest, planeWithHyperplane)
+{
+  const Point4D p0{ 0.0, 0.0, 0.0, 0.0 };
+  const Point4D p1{ 1.0, 0.0, 0.0, 0.0 };
+  const Point4D p2{ 0.0, 1.0, 1.0, 1.0 };
+  const Point4D p3{ 10.0, 0.0, 0.0, 0.0 };
+  const Point4D p4{ 0.0, 10.0, 0.0, 0.0 };
+  const Point4D p5{ 0.0, 0.0, 10.0, 0.0 };
+  const Point4D p6{ 0.0, 0.0, 0.0, 10.0 };
+  const auto space0 = affine::Affine_space<double, 4>::spanning_space(
+    { p0, p1, p2 }, affine::Equal_to_precision());
+  const auto space1 = affine::Affine_space<double, 4>::spanning_space(
+    { p3, p4, p5, p6 }, affine::Equal_to_precision());
+
+  const auto intersection =
+    affine::intersection(space0, space1, affine::Equal_to_precision());
+  EXPECT_PRED1(has_value_test, intersection);
+  EXPECT_EQ(intersection->dimension(), 1);
+  EXPECT_PRED3(element_test,
+               space0,
+               intersection->point() + intersection->base(0),
+               affine::Equal_to_precision(1e-14));
+  EXPECT_PRED3(element_test,
+               space1,
+               intersection->point() + intersection->base(0),
+               affine::Equal_to_precision(1e-14));
+}
+
+TEST(IntersectionTest, expiringOperand)
+{
+  const Point3D p0{ 0.0, 0.0, 0.0 };
+  const Point3D p1{ 1.0, 0.0, 0.0 };
+  const Point3D p2{ 0.0, 1.0, 0.0 };
+  const Point3D p3{ 0.0, 0.0, 1.0 };
+  const auto full = affine::Affine_space<double, 3>::spanning_space(
+    { p0, p1, p2, p3 }, affine::Equal_to_precision());
+  const auto plane = affine::Affine_space<double, 3>::spanning_space(
+    { p0, p1, p3 }, affine::Equal_to_precision());
+  auto line = affine::Affine_space<double, 3>::spanning_space(
+    { p0, p1 }, affine::Equal_to_precision());
+  const auto* line_storage = line.base().data();
+
+  auto contained =
+    intersection(full, std::move(line), affine::Equal_to_precision());
+  EXPECT_PRED1(has_value_test, contained);
+  EXPECT_EQ(contained->base().data(), line_storage);
+  contained =
+    intersection(std::move(*contained), plane, affine::Equal_to_precision());
+  EXPECT_PRED1(has_value_test, contained);
+  EXPECT_EQ(contained->base().data(), line_storage);
+
+  const Point4D q0{ 0.0, 0.0, 0.0, 0.0 };
+  const Point4D q1{ 0.0, 1.0, 0.0, 0.0 };
+  const Point4D q2{ 0.0, 0.0, 1.0, 0.0 };
+  const Point4D q3{ 1.0, 0.0, 0.0, 0.0 };
+  const Point4D q4{ 0.0, 0.0, 0.0, 1.0 };
+  auto space = affine::Affine_space<double, 4>::spanning_space(
+    { q0, q1, q2 }, affine::Equal_to_precision());
+  const auto* space_storage = space.base().data();
+  const auto hyperplane = affine::Affine_space<double, 4>::spanning_space(
+    { q1, q2, q3, q4 }, affine::Equal_to_precision());
+  const auto expected =
+    intersection(space, hyperplane, affine::Equal_to_precision());
+  const auto result =
+    intersection(std::move(space), hyperplane, affine::Equal_to_precision());
+  EXPECT_PRED1(has_value_test, result);
+  EXPECT_EQ(result->dimension(), 1);
+  EXPECT_EQ(result->point(), expected->point());
+  EXPECT_EQ(result->base(0), expected->base(0));
+  EXPECT_EQ(result->base().data(), space_storage);
+  EXPECT_PRED3(element_test, *result, q1, affine::Equal_to_precision(1e-14));
+  EXPECT_PRED3(element_test, *result, q2, affine::Equal_to_precision(1e-14));
+}
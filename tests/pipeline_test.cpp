@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// skips -Woverloaded-virtual warnings for capd library
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Woverloaded-virtual"
+#include <capd/capdlib.h>
+#pragma GCC diagnostic pop
+
+#include "affine/affine.h"
+#include "affine/pipeline.h"
+#include "./test_utils.h"
+
+TEST(PipelineTest, inOrder)
+{
+  using Aff_space = affine::Affine_space<double, 3>;
+  constexpr std::size_t chunks = 50;
+  constexpr std::size_t chunk_size = 7;
+  const Point3D e0{ 1.0, 0.0, 0.0 };
+  const Point3D e1{ 0.0, 1.0, 0.0 };
+  const Point3D e2{ 0.0, 0.0, 1.0 };
+  auto make_pair = [&](std::size_t i) {
+    const auto t = static_cast<double>(i);
+    return std::pair{
+      Aff_space(t * e0, std::vector{ e1, e2 }, affine::Equal_to_precision()),
+      Aff_space(t * e2, std::vector{ e0 + e1 }, affine::Equal_to_precision())
+    };
+  };
+  auto pipeline = affine::intersection_pipeline<double, 3>(
+    affine::Equal_to_precision(), { .threads = 4, .capacity = 3 });
+
+  std::jthread producer([&] {
+    for (std::size_t c = 0; c < chunks; ++c) {
+      std::vector<std::pair<Aff_space, Aff_space>> chunk;
+      for (std::size_t i = 0; i < chunk_size; ++i)
+        chunk.push_back(make_pair(c * chunk_size + i));
+      pipeline.submit(std::move(chunk));
+    }
+    pipeline.close();
+  });
+
+  std::size_t i = 0;
+  while (auto result = pipeline.next()) {
+    ASSERT_EQ(result->size(), chunk_size);
+    for (auto&& space : *result) {
+      auto [lhs, rhs] = make_pair(i++);
+      const auto expected =
+        affine::intersection(lhs, rhs, affine::Equal_to_precision());
+      ASSERT_PRED1(has_value_test, space);
+      EXPECT_EQ(space->dimension(), 0);
+      EXPECT_EQ(space->point(), expected->point());
+    }
+  }
+  EXPECT_EQ(i, chunks * chunk_size);
+  EXPECT_THROW(pipeline.submit({}), std::logic_error);
+}
+
+TEST(PipelineTest, exception)
+{
+  affine::Pipeline<int, int> pipeline(
+    [](int&& x) {
+      if (x < 0)
+        throw std::invalid_argument("negative");
+      return 2 * x;
+    },
+    { .threads = 2 });
+  pipeline.submit({ 1, 2, 3 });
+  pipeline.submit({ 4, -5 });
+  pipeline.submit({ 6 });
+  pipeline.close();
+
+  EXPECT_EQ(pipeline.next(), (std::vector{ 2, 4, 6 }));
+  EXPECT_THROW(pipeline.next(), std::invalid_argument);
+  EXPECT_EQ(pipeline.next(), (std::vector{ 12 }));
+  EXPECT_EQ(pipeline.next(), std::nullopt);
+}
+
+TEST(PipelineTest, submitToClosedFullPipeline)
+{
+  affine::Pipeline<int, int> pipeline([](int&& x) { return x; },
+                                      { .threads = 1, .capacity = 1 });
+  pipeline.submit({ 1 });
+  pipeline.close();
+
+  EXPECT_THROW(pipeline.submit({ 2 }), std::logic_error);
+  EXPECT_EQ(pipeline.next(), (std::vector{ 1 }));
+  EXPECT_EQ(pipeline.next(), std::nullopt);
+}
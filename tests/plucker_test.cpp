@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+
+#include <functional>
+#include <vector>
+
+// skips -Woverloaded-virtual warnings for capd library
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Woverloaded-virtual"
+#include <capd/capdlib.h>
+#pragma GCC diagnostic pop
+
+#include "affine/affine.h"
+#include "./test_utils.h"
+
+using Plucker = affine::Plucker_line<double>;
+
+TEST(PluckerTest, conversion)
+{
+  const Point3D p0{ 1.0, 0.0, 0.0 };
+  const Point3D p1{ 0.0, 1.0, 1.0 };
+  const auto space = affine::Affine_space<double, 3>::spanning_space(
+    { p0, p1 }, affine::Equal_to_precision());
+  const Plucker line(space);
+  const auto round_trip = line.to_affine_space(affine::Equal_to_precision());
+
+  EXPECT_NEAR(line.point() * line.direction(), 0, 1e-15);
+  EXPECT_EQ(round_trip.dimension(), 1);
+  EXPECT_PRED3(element_test, round_trip, p0, affine::Equal_to_precision());
+  EXPECT_PRED3(element_test, round_trip, p1, affine::Equal_to_precision());
+  EXPECT_THROW(Plucker(affine::Affine_space<double, 3>(p0)),
+               std::invalid_argument);
+}
+
+TEST(PluckerTest, lineWithLine)
+{
+  const Point3D p0{ 1.0, 0.0, 0.0 };
+  const Point3D p1{ 0.0, 1.0, 1.0 };
+  const Point3D p2{ 0.0, 0.0, 0.0 };
+  const Point3D p3{ 1.0, 1.0, 1.0 };
+  const Point3D p4{ 0.0, 0.0, 1.0 };
+  const auto line0 = Plucker::through(p0, p1);
+  const auto line1 = Plucker::through(p2, p3);
+  const auto skew = Plucker::through(p2, p4);
+  const auto parallel = Plucker::through(p0 + p4, p1 + p4);
+  const auto coincident = Plucker::through(2.0 * p1 - p0, p1);
+
+  EXPECT_TRUE(intersects(line0, line1, affine::Equal_to_precision()));
+  EXPECT_FALSE(intersects(line0, skew, affine::Equal_to_precision()));
+  EXPECT_TRUE(coplanar(line0, parallel, affine::Equal_to_precision()));
+  EXPECT_FALSE(intersects(line0, parallel, affine::Equal_to_precision()));
+  EXPECT_TRUE(intersects(line0, coincident, affine::Equal_to_precision()));
+  EXPECT_GT(side(line0, skew) * side(skew, line0), 0);
+}
+
+TEST(PluckerTest, batched)
+{
+  const Point3D p0{ 7.06976, 3.01336, 0.573289 };
+  const Point3D p1{ 0.555447, 9.69536, -1.08835 };
+  const Point3D p2{ -3.03373, 3.06169, -5.20502 };
+  const Point3D p3{ -2.43233, -8.75036, 4.67991 };
+  const std::vector lines{ Plucker::through(p0, p1),
+                           Plucker::through(p1, p2),
+                           Plucker::through(p2, p3),
+                           Plucker::through(p3, p0) };
+  affine::Plucker_lines<double> soa;
+  for (auto&& line : lines)
+    soa.push_back(line);
+  const auto query = Plucker::through(p0, p2);
+  std::vector<double> result(soa.size());
+  side(query, soa, std::span(result));
+
+  EXPECT_EQ(soa.size(), 4);
+  for (std::size_t i = 0; i < lines.size(); ++i)
+    EXPECT_NEAR(result[i], side(query, lines[i]), 1e-12);
+  EXPECT_NEAR(result[0], 0, 1e-12);
+}
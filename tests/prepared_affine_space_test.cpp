@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+
+#include <functional>
+#include <vector>
+
+// skips -Woverloaded-virtual warnings for capd library
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Woverloaded-virtual"
+#include <capd/capdlib.h>
+#pragma GCC diagnostic pop
+
+#include "affine/affine.h"
+#include "./test_utils.h"
+
+TEST(PreparedAffineSpaceTest, line)
+{
+  const Point4D p0{ 0.491742, -4.73389, -6.07428, 0.246362 };
+  const Point4D p1{ -4.85797, 6.30975, -0.959427, -5.05184 };
+  const Point4D p2{ -3.53352, 6.14748, 6.88908, -8.43334 };
+  const double t = 2.79153;
+  const affine::Affine_space space(
+    p0, std::vector{ p1 }, affine::Equal_to_precision());
+  const affine::Prepared_affine_space prepared(space,
+                                               affine::Equal_to_precision());
+
+  EXPECT_FALSE(prepared.uses_complement());
+  EXPECT_EQ(prepared.dimension(), 1);
+  EXPECT_PRED3(element_test,
+               prepared,
+               p0 + t * p1,
+               affine::Equal_to_precision(1e-14));
+  EXPECT_PRED3(std::not_fn(element_test),
+               prepared,
+               p0 + t * p2,
+               affine::Equal_to_precision());
+  EXPECT_NEAR(prepared.distance(p0 + t * p1), 0, 1e-13);
+  const auto projection = prepared.projection(p0 + t * p2);
+  EXPECT_PRED3(
+    element_test, space, projection, affine::Equal_to_precision(1e-13));
+  EXPECT_NEAR((p0 + t * p2 - projection) * space.base(0), 0, 1e-13);
+}
+
+TEST(PreparedAffineSpaceTest, hyperplane)
+{
+  const Point4D p0{ 0.491742, -4.73389, -6.07428, 0.246362 };
+  const std::vector<Point4D> generators{
+    { -4.85797, 6.30975, -0.959427, -5.05184 },
+    { -3.53352, 6.14748, 6.88908, -8.43334 },
+    { -7.37983, -0.708072, -0.999901, -9.75365 },
+  };
+  const Point4D normal{ 1.0, 0.0, 0.0, 0.0 };
+  const affine::Affine_space space(
+    p0, generators, affine::Equal_to_precision());
+  const affine::Prepared_affine_space prepared(space,
+                                               affine::Equal_to_precision());
+
+  EXPECT_TRUE(prepared.uses_complement());
+  EXPECT_EQ(prepared.dimension(), 3);
+  EXPECT_PRED3(element_test,
+               prepared,
+               p0 + 1.5 * generators[0] - 0.5 * generators[2],
+               affine::Equal_to_precision(1e-13));
+  EXPECT_PRED3(std::not_fn(element_test),
+               prepared,
+               p0 + normal,
+               affine::Equal_to_precision());
+  const Point4D q{ 1.0, 2.0, 3.0, 4.0 };
+  const auto projection = prepared.projection(q);
+  EXPECT_PRED3(
+    element_test, space, projection, affine::Equal_to_precision(1e-13));
+  EXPECT_NEAR(prepared.distance(q),
+              capd::vectalg::euclNorm(q - projection),
+              1e-13);
+}
@@ -72,3 +72,25 @@ TEST(SpanningSpaceTest, threePoints)
   EXPECT_PRED3(element_test, space_3d, p2_3d, affine::Equal_to_precision());
   EXPECT_EQ(space_3d.dimension(), 2);
 }
+
+TEST(SpanningSpaceTest, fromVector)
+{
+  const Point3D p0{ 1.0, 0.0, 0.0 };
+  const Point3D p1{ 0.0, 1.0, 0.0 };
+  const Point3D p2{ 0.0, 0.0, 1.0 };
+  std::vector<Point3D> points{ p0, p1, p2 };
+  const auto* storage = points.data();
+  const auto space = affine::Affine_space<double, 3>::spanning_space(
+    std::move(points), affine::Equal_to_precision());
+
+  EXPECT_EQ(space.base().data(), storage);
+  EXPECT_EQ(space.point(), p0);
+  EXPECT_EQ(space.dimension(), 2);
+  EXPECT_PRED3(element_test, space, p1, affine::Equal_to_precision(1e-14));
+  EXPECT_PRED3(element_test, space, p2, affine::Equal_to_precision(1e-14));
+  using Aff_space = affine::Affine_space<double, 3>;
+  std::vector<Point3D> empty;
+  EXPECT_THROW(
+    Aff_space::spanning_space(std::move(empty), affine::Equal_to_precision()),
+    std::invalid_argument);
+}
@@ -13,6 +13,8 @@ using Point2D = capd::vectalg::Vector<double, 2>;
 using Point3D = capd::vectalg::Vector<double, 3>;
 using Point4D = capd::vectalg::Vector<double, 4>;
 
+using FPoint4D = capd::vectalg::Vector<float, 4>;
+
 using IPoint1D = capd::vectalg::Vector<capd::DInterval, 1>;
 using IPoint2D = capd::vectalg::Vector<capd::DInterval, 2>;
 using IPoint3D = capd::vectalg::Vector<capd::DInterval, 3>;
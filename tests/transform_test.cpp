@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+
+#include <functional>
+#include <vector>
+
+// skips -Woverloaded-virtual warnings for capd library
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Woverloaded-virtual"
+#include <capd/capdlib.h>
+#pragma GCC diagnostic pop
+
+#include "affine/affine.h"
+#include "./test_utils.h"
+
+// The conformality of the map cannot be asserted by the caller.
+template<class Aff_space>
+concept Takes_conformality =
+  requires(Aff_space space, Aff_space::Matrix map, Aff_space::Point t) {
+    space.transform(map, t, true, affine::Equal_to_precision());
+  };
+static_assert(!Takes_conformality<affine::Affine_space<double, 3>>);
+
+TEST(TransformTest, rigid)
+{
+  using Aff_space = affine::Affine_space<double, 3>;
+  const Point3D p0{ 3.0, -1.0, -2.0 };
+  const Point3D p1{ 4.0, 8.0, 3.0 };
+  const Point3D p2{ -12.0, 6.0, 6.0 };
+  const Point3D translation{ 1.0, 2.0, 3.0 };
+  Aff_space::Matrix rotation;
+  rotation[0][1] = -1.0;
+  rotation[1][0] = 1.0;
+  rotation[2][2] = 1.0;
+  auto rotate = [&](const Point3D& p) { return rotation * p + translation; };
+  const auto space =
+    Aff_space::spanning_space({ p0, p1, p2 }, affine::Equal_to_precision());
+  const auto moved = affine::transform(
+    space, rotation, translation, affine::Equal_to_precision());
+
+  EXPECT_EQ(moved.dimension(), 2);
+  EXPECT_EQ(moved.base(0), rotation * space.base(0));
+  EXPECT_EQ(moved.base(1), rotation * space.base(1));
+  EXPECT_PRED3(
+    element_test, moved, rotate(p1), affine::Equal_to_precision(1e-14));
+  EXPECT_PRED3(
+    element_test, moved, rotate(p2), affine::Equal_to_precision(1e-14));
+  EXPECT_PRED3(
+    std::not_fn(element_test), moved, p1, affine::Equal_to_precision());
+}
+
+TEST(TransformTest, similarity)
+{
+  using Aff_space = affine::Affine_space<double, 3>;
+  const Point3D p0{ 3.0, -1.0, -2.0 };
+  const Point3D p1{ 4.0, 8.0, 3.0 };
+  const Point3D p2{ -12.0, 6.0, 6.0 };
+  const Point3D translation{ 1.0, 2.0, 3.0 };
+  Aff_space::Matrix similarity;
+  similarity[0][0] = 1.2;
+  similarity[0][1] = -1.6;
+  similarity[1][0] = 1.6;
+  similarity[1][1] = 1.2;
+  similarity[2][2] = 2.0;
+  Aff_space::Matrix shear;
+  shear[0][0] = 1.0;
+  shear[0][1] = 2.0;
+  shear[1][1] = 1.0;
+  shear[2][2] = 1.0;
+  auto map = [&](const Point3D& p) { return similarity * p + translation; };
+  const auto space =
+    Aff_space::spanning_space({ p0, p1, p2 }, affine::Equal_to_precision());
+  const auto moved = affine::transform(
+    space, similarity, translation, affine::Equal_to_precision());
+
+  EXPECT_TRUE(
+    affine::detail::conformal(similarity, affine::Equal_to_precision(1e-14)));
+  EXPECT_FALSE(
+    affine::detail::conformal(shear, affine::Equal_to_precision(1e-14)));
+  EXPECT_EQ(moved.dimension(), 2);
+  EXPECT_NEAR(moved.base(0) * moved.base(0), 1, 1e-14);
+  EXPECT_NEAR(moved.base(1) * moved.base(1), 1, 1e-14);
+  EXPECT_NEAR(moved.base(0) * moved.base(1), 0, 1e-14);
+  EXPECT_PRED3(
+    element_test, moved, map(p1), affine::Equal_to_precision(1e-13));
+  EXPECT_PRED3(
+    element_test, moved, map(p2), affine::Equal_to_precision(1e-13));
+}
+
+TEST(TransformTest, batched)
+{
+  using Aff_space = affine::Affine_space<double, 3>;
+  const Point3D p0{ 3.0, -1.0, -2.0 };
+  const Point3D p1{ 4.0, 8.0, 3.0 };
+  const Point3D p2{ -12.0, 6.0, 6.0 };
+  const Point3D translation{ 0.0, -1.0, 0.5 };
+  Aff_space::Matrix shear;
+  shear[0][0] = 1.0;
+  shear[0][1] = 2.0;
+  shear[1][1] = 1.0;
+  shear[2][2] = 3.0;
+  auto map = [&](const Point3D& p) { return shear * p + translation; };
+  std::vector spaces{
+    Aff_space::spanning_space({ p0, p1 }, affine::Equal_to_precision()),
+    Aff_space::spanning_space({ p0, p1, p2 }, affine::Equal_to_precision()),
+  };
+  affine::transform(spaces, shear, translation, affine::Equal_to_precision());
+
+  EXPECT_EQ(spaces[0].dimension(), 1);
+  EXPECT_EQ(spaces[1].dimension(), 2);
+  EXPECT_NEAR(spaces[1].base(0) * spaces[1].base(1), 0, 1e-14);
+  EXPECT_PRED3(
+    element_test, spaces[0], map(p1), affine::Equal_to_precision(1e-13));
+  EXPECT_PRED3(
+    element_test, spaces[1], map(p2), affine::Equal_to_precision(1e-13));
+  EXPECT_PRED3(std::not_fn(element_test),
+               spaces[0],
+               map(p2),
+               affine::Equal_to_precision());
+}